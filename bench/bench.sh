@@ -0,0 +1,103 @@
+#!/bin/sh
+#
+# bench.sh, end to end benchmark of gf_mds, added on October 18, 2026
+#
+# this file is part of gf_mds
+#
+# run by "make bench": writes synthetic datasets with gen_dataset, runs the
+# full gf_mds_stats cli on each of them BENCH_RUNS times and keeps the
+# fastest run. prints a table and writes BENCH_DIR/bench.json with one case
+# per line, so results of two commits can be compared with
+#
+#   sh bench/bench.sh -compare old.json new.json
+#
+# environment: BENCH_DIR (default: bench_out), BENCH_RUNS (default: 3),
+# GF_MDS (default: ./gf_mds_stats), GEN_DATASET (default: ./gen_dataset)
+
+BENCH_DIR=${BENCH_DIR:-bench_out}
+BENCH_RUNS=${BENCH_RUNS:-3}
+GF_MDS=${GF_MDS:-./gf_mds_stats}
+GEN_DATASET=${GEN_DATASET:-./gen_dataset}
+
+# name years timeres gaps gf_mds_flags
+CASES="
+hh_1y 1 30 0.3 -
+hh_4y 4 30 0.3 -
+hh_1y_gaps60 1 30 0.6 -
+h_4y 4 60 0.3 -hourly
+qh_1y 1 15 0.3 -quaterhourly
+"
+
+# compare rows per second of two bench.json
+if [ "$1" = "-compare" ]; then
+	if [ $# -ne 3 ]; then
+		echo "usage: $0 -compare old.json new.json"
+		exit 1
+	fi
+	awk '
+		function field(s, name,    r) {
+			if ( !match(s, "\"" name "\": [^,}]+") ) return ""
+			r = substr(s, RSTART, RLENGTH)
+			sub(/^[^:]*: /, "", r)
+			gsub(/"/, "", r)
+			return r
+		}
+		/"case"/ {
+			name = field($0, "case")
+			if ( FILENAME == ARGV[1] ) { old[name] = field($0, "rows_per_second"); next }
+			if ( !(name in old) ) next
+			new = field($0, "rows_per_second")
+			printf "%-16s %12.0f %12.0f %+8.1f%%\n", name, old[name], new, (new / old[name] - 1) * 100
+		}
+		BEGIN { printf "%-16s %12s %12s %9s\n", "case", "old rows/s", "new rows/s", "change" }
+	' "$2" "$3"
+	exit $?
+fi
+
+if [ ! -x "$GF_MDS" ] || [ ! -x "$GEN_DATASET" ]; then
+	echo "$GF_MDS or $GEN_DATASET not found, use make bench"
+	exit 1
+fi
+
+mkdir -p "$BENCH_DIR/data" "$BENCH_DIR/output" || exit 1
+COMMIT=$(git rev-parse --short HEAD 2>/dev/null || echo unknown)
+JSON="$BENCH_DIR/bench.json"
+
+printf "%-16s %9s %9s %9s %9s %12s %10s\n" case rows import fill output rows/s peak_kb
+printf '{\n\t"commit": "%s",\n\t"runs": %d,\n\t"cases": [\n' "$COMMIT" "$BENCH_RUNS" > "$JSON"
+SEPARATOR=""
+echo "$CASES" | while read NAME YEARS TIMERES GAPS FLAGS; do
+	[ -z "$NAME" ] && continue
+	[ "$FLAGS" = "-" ] && FLAGS=""
+	"$GEN_DATASET" -output="$BENCH_DIR/data/$NAME.csv" -years=$YEARS -timeres=$TIMERES -gaps=$GAPS || exit 1
+
+	rm -f "$BENCH_DIR/$NAME".[0-9]*.json
+	RUN=0
+	while [ $RUN -lt $BENCH_RUNS ]; do
+		"$GF_MDS" -input="$BENCH_DIR/data/$NAME.csv" -output="$BENCH_DIR/output/" $FLAGS -stats="$BENCH_DIR/$NAME.$RUN.json" > "$BENCH_DIR/$NAME.log" || exit 1
+		RUN=$((RUN+1))
+	done
+
+	# fastest run, phases are summed over the jobs of the run
+	LINE=$(for F in "$BENCH_DIR/$NAME".[0-9]*.json; do
+		awk '
+			function wall(s) { match(s, /"wall": [0-9.]+/); return substr(s, RSTART+8, RLENGTH-8) + 0 }
+			/^\t\t\t"rows":/ { gsub(/[^0-9]/, ""); rows += $0 }
+			/^\t\t\t"import":/ { import += wall($0) }
+			/^\t\t\t"fill":/ { fill += wall($0) }
+			/^\t\t\t"output":/ { output += wall($0) }
+			/"peak_memory_kb":/ { gsub(/[^0-9]/, ""); if ( $0 + 0 > peak ) peak = $0 + 0 }
+			END { printf "%d %.6f %.6f %.6f %.6f %d\n", rows, import, fill, output, import + fill + output, peak }
+		' "$F"
+	done | sort -g -k5 | head -1)
+	set -- $LINE
+	RATE=$(awk "BEGIN { printf \"%.0f\", $1 / ($5 > 0 ? $5 : 1) }")
+
+	printf "%-16s %9d %9.4f %9.4f %9.4f %12s %10d\n" "$NAME" $1 $2 $3 $4 $RATE $6
+	printf '%s\t\t{ "case": "%s", "years": %d, "timeres": %d, "gaps": %s, "rows": %d, "import": %s, "fill": %s, "output": %s, "total": %s, "rows_per_second": %s, "peak_memory_kb": %d }' \
+		"$SEPARATOR" "$NAME" $YEARS $TIMERES $GAPS $1 $2 $3 $4 $5 $RATE $6 >> "$JSON"
+	SEPARATOR=",
+"
+done || exit 1
+printf '\n\t]\n}\n' >> "$JSON"
+echo "results written to $JSON"
@@ -0,0 +1,367 @@
+/*
+	gen_dataset.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	synthetic dataset generator, added on October 18, 2026
+
+	writes a csv in the format read by gf_mds with TIMESTAMP_START,
+	TIMESTAMP_END, NEE, SW_IN, TA and VPD. drivers follow the sun
+	elevation of a mid latitude site and the seasons, NEE is a light
+	response minus a temperature driven respiration, all with noise.
+	gaps of NEE are runs whose length is picked from a list, so that
+	their share of rows is close to the one requested.
+	the same seed gives the same file on every platform
+*/
+
+/* includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../src/common.h"
+
+/* constants */
+#define INVALID_VALUE		-9999
+#define LATITUDE			45.
+#define GAP_LENGTHS_MAX		32
+#ifndef M_PI
+#define M_PI				3.14159265358979323846
+#endif
+
+/* */
+static const char usage[] =	"gen_dataset writes a synthetic halfhourly, hourly or quaterhourly dataset\n\n"
+							"  -output=filename -> file to create (required)\n"
+							"  -year=value -> first year (default: 2004)\n"
+							"  -years=value -> years to write (default: 1)\n"
+							"  -first_day=value -> day of first year to start from (default: 1)\n"
+							"  -timeres=15|30|60 -> minutes between rows (default: 30)\n"
+							"  -gaps=value -> share of NEE rows missing, from 0 to 0.95 (default: 0.3)\n"
+							"  -gap_lengths=value[,value...] -> lengths in rows of NEE gaps,\n"
+							"    each gap picks one of them (default: %s)\n"
+							"  -driver_gaps=value -> share of missing rows of each driver, from 0 to 1\n"
+							"    (default: 0.01)\n"
+							"  -missing=SW_IN|TA|VPD -> leave a driver without values, can be repeated\n"
+							"  -seed=value -> random seed (default: 1)\n\n";
+
+static const char default_gap_lengths[] = "1,1,2,3,6,12,48,144,480";
+
+/* errors */
+static const char err_arg_needs_param[] = "%s parameter not specified.\n\n";
+static const char err_unable_convert_value[] = "unable to convert value \"%s\" for %s.\n\n";
+static const char err_output_not_specified[] = "output not specified.\n\n";
+static const char err_unable_create_file[] = "unable to create %s.\n";
+
+/* */
+static char *output_path = NULL;
+static int year = 2004;
+static int years_count = 1;
+static int minutes = 30;
+static double gaps = 0.3;
+static double driver_gaps = 0.01;
+static int seed = 1;
+static int first_day = 1;
+static int missing = 0;				/* bit 0 is SW_IN, 1 is TA and 2 is VPD */
+static int gap_lengths[GAP_LENGTHS_MAX];
+static int gap_lengths_count = 0;
+static unsigned long long random_state;
+
+/* xorshift64*, same sequence on every platform */
+static double get_random(void) {
+	random_state ^= random_state >> 12;
+	random_state ^= random_state << 25;
+	random_state ^= random_state >> 27;
+	return ((random_state * 2685821657736338717ULL) >> 11) * (1. / 9007199254740992.);
+}
+
+/* box-muller */
+static double get_gaussian(const double sd) {
+	double u;
+
+	do {
+		u = get_random();
+	} while ( u <= 0. );
+	return sd * sqrt(-2. * log(u)) * cos(2. * M_PI * get_random());
+}
+
+/* */
+static int set_string(char *arg, char *param, void *p) {
+	if ( !param || !param[0] ) {
+		printf(err_arg_needs_param, arg);
+		return 0;
+	}
+	*(char **)p = param;
+	return 1;
+}
+
+/* */
+static int set_int(char *arg, char *param, void *p) {
+	int error;
+	int value;
+
+	if ( !param ) {
+		printf(err_arg_needs_param, arg);
+		return 0;
+	}
+	value = convert_string_to_int(param, &error);
+	if ( error || (value < 0) ) {
+		printf(err_unable_convert_value, param, arg);
+		return 0;
+	}
+	*(int *)p = value;
+	return 1;
+}
+
+/* */
+static int set_share(char *arg, char *param, void *p) {
+	int error;
+	double value;
+
+	if ( !param ) {
+		printf(err_arg_needs_param, arg);
+		return 0;
+	}
+	value = convert_string_to_prec(param, &error);
+	if ( error || (value < 0.) || (value > 1.) ) {
+		printf(err_unable_convert_value, param, arg);
+		return 0;
+	}
+	*(double *)p = value;
+	return 1;
+}
+
+/* */
+static int set_gap_lengths(char *arg, char *param, void *p) {
+	int error;
+	int value;
+	char *token;
+	char *q;
+
+	if ( !param || !param[0] ) {
+		printf(err_arg_needs_param, arg);
+		return 0;
+	}
+	gap_lengths_count = 0;
+	for ( token = string_tokenizer(param, ",", &q); token; token = string_tokenizer(NULL, ",", &q) ) {
+		value = convert_string_to_int(token, &error);
+		if ( error || (value <= 0) || (GAP_LENGTHS_MAX == gap_lengths_count) ) {
+			printf(err_unable_convert_value, token, arg);
+			return 0;
+		}
+		gap_lengths[gap_lengths_count++] = value;
+	}
+	return 1;
+}
+
+/* */
+static int set_missing(char *arg, char *param, void *p) {
+	int i;
+	const char *const names[] = { "SW_IN", "TA", "VPD" };
+
+	if ( !param ) {
+		printf(err_arg_needs_param, arg);
+		return 0;
+	}
+	for ( i = 0; i < SIZEOF_ARRAY(names); i++ ) {
+		if ( !string_compare_i(param, names[i]) ) {
+			missing |= 1 << i;
+			return 1;
+		}
+	}
+	printf(err_unable_convert_value, param, arg);
+	return 0;
+}
+
+/* */
+static int show_help(char *arg, char *param, void *p) {
+	printf(usage, default_gap_lengths);
+	exit(0);
+	return 0;
+}
+
+/* sine of sun elevation, day is 1 based, hour is local solar time */
+static double get_sun_elevation(const int day, const double hour) {
+	double declination;
+	double latitude;
+
+	declination = 23.45 * M_PI / 180. * sin(2. * M_PI * (284 + day) / 365.);
+	latitude = LATITUDE * M_PI / 180.;
+	return sin(latitude) * sin(declination) + cos(latitude) * cos(declination) * cos(M_PI * (hour - 12.) / 12.);
+}
+
+/* */
+static void write_value(FILE *const f, const double value, const int missing) {
+	if ( missing ) {
+		fprintf(f, ",%d", INVALID_VALUE);
+	} else {
+		fprintf(f, ",%.3f", value);
+	}
+}
+
+/* */
+static int write_dataset(FILE *const f) {
+	int i;
+	int y;
+	int row;
+	int rows_count;
+	int timeres;
+	int gap;
+	int day;
+	double hour;
+	double mean_gap_length;
+	double gap_start;
+	double clouds;
+	double sw_in;
+	double ta;
+	double vpd;
+	double rh;
+	double gpp;
+	double reco;
+	double nee;
+	char buffer[TIMESTAMP_STRING_SIZE];
+
+	switch ( minutes ) {
+		case 15: timeres = QUATERHOURLY_TIMERES; break;
+		case 30: timeres = HALFHOURLY_TIMERES; break;
+		case 60: timeres = HOURLY_TIMERES; break;
+		default: return 0;
+	}
+
+	/* gaps start with a probability that gives the requested share */
+	mean_gap_length = 0.;
+	for ( i = 0; i < gap_lengths_count; i++ ) {
+		mean_gap_length += gap_lengths[i];
+	}
+	mean_gap_length /= gap_lengths_count;
+	gap_start = gaps / (mean_gap_length * (1. - gaps));
+
+	fputs("TIMESTAMP_START,TIMESTAMP_END,NEE,SW_IN,TA,VPD\n", f);
+	gap = 0;
+	clouds = 0.8;
+	for ( y = year; y < year + years_count; y++ ) {
+		rows_count = get_rows_count_by_timeres(timeres, y);
+		for ( row = (y == year) ? (first_day - 1) * 1440 / minutes : 0; row < rows_count; row++ ) {
+			day = row * minutes / 1440 + 1;
+			hour = (row * minutes % 1440 + minutes / 2.) / 60.;
+
+			/* clouds change slowly around a clear sky */
+			clouds += 0.02 * (0.85 - clouds) + get_gaussian(0.03);
+			if ( clouds < 0.2 ) clouds = 0.2;
+			if ( clouds > 1. ) clouds = 1.;
+
+			sw_in = 1100. * get_sun_elevation(day, hour) * clouds;
+			if ( sw_in < 0. ) sw_in = 0.;
+			sw_in += fabs(get_gaussian(3.));
+
+			ta = 12. - 10. * cos(2. * M_PI * (day - 15) / 365.)
+					+ 5. * sin(M_PI * (hour - 9.) / 12.) * clouds
+					+ get_gaussian(0.8);
+
+			rh = 0.75 - 0.25 * sin(M_PI * (hour - 9.) / 12.) + get_gaussian(0.05);
+			if ( rh < 0.1 ) rh = 0.1;
+			if ( rh > 1. ) rh = 1.;
+			vpd = 6.1078 * exp(17.27 * ta / (ta + 237.3)) * (1. - rh);
+
+			/* light response limited by vpd and season, respiration by ta */
+			gpp = 0.05 * sw_in * 35. / (0.05 * sw_in + 35.);
+			gpp *= (vpd > 10.) ? 10. / vpd : 1.;
+			gpp *= 0.6 - 0.4 * cos(2. * M_PI * (day - 15) / 365.);
+			reco = 2. * exp(0.05 * ta);
+			nee = reco - gpp + get_gaussian(1.5);
+
+			if ( gap ) {
+				--gap;
+			} else if ( get_random() < gap_start ) {
+				gap = gap_lengths[(int)(get_random() * gap_lengths_count)] - 1;
+				nee = INVALID_VALUE;
+			}
+
+			fputs(timestamp_get_by_row_s_r(row, y, timeres, 1, buffer), f);
+			fputc(',', f);
+			fputs(timestamp_get_by_row_s_r(row, y, timeres, 0, buffer), f);
+			write_value(f, nee, (INVALID_VALUE == nee) || (gap > 0));
+			write_value(f, sw_in, (missing & 1) || (get_random() < driver_gaps));
+			write_value(f, ta, (missing & 2) || (get_random() < driver_gaps));
+			write_value(f, vpd, (missing & 4) || (get_random() < driver_gaps));
+			fputc('\n', f);
+		}
+	}
+
+	return !ferror(f);
+}
+
+/* */
+int main(int argc, char *argv[]) {
+	int ok;
+	FILE *f;
+	char buffer[sizeof default_gap_lengths];
+
+	const ARGUMENT args[] = {
+		{ "output", set_string, &output_path },
+		{ "year", set_int, &year },
+		{ "years", set_int, &years_count },
+		{ "timeres", set_int, &minutes },
+		{ "gaps", set_share, &gaps },
+		{ "gap_lengths", set_gap_lengths, NULL },
+		{ "first_day", set_int, &first_day },
+		{ "driver_gaps", set_share, &driver_gaps },
+		{ "missing", set_missing, NULL },
+		{ "seed", set_int, &seed },
+		{ "h", show_help, NULL },
+		{ "?", show_help, NULL },
+		{ "help", show_help, NULL },
+	};
+
+	strcpy(buffer, default_gap_lengths);
+	set_gap_lengths("gap_lengths", buffer, NULL);
+	if ( !parse_arguments(argc, argv, args, SIZEOF_ARRAY(args)) ) {
+		return 1;
+	}
+	if ( !output_path ) {
+		puts(err_output_not_specified);
+		printf(usage, default_gap_lengths);
+		return 1;
+	}
+	if (	((15 != minutes) && (30 != minutes) && (60 != minutes))
+			|| !years_count
+			|| (gaps > 0.95)
+			|| (first_day < 1) || (first_day > 365) ) {
+		printf(usage, default_gap_lengths);
+		return 1;
+	}
+
+	random_state = 0x9E3779B97F4A7C15ULL ^ (unsigned long long)seed;
+	f = fopen(output_path, "w");
+	if ( !f ) {
+		printf(err_unable_create_file, output_path);
+		return 1;
+	}
+	ok = write_dataset(f);
+	if ( fclose(f) || !ok ) {
+		printf(err_unable_create_file, output_path);
+		return 1;
+	}
+
+	return 0;
+}
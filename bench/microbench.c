@@ -0,0 +1,562 @@
+/*
+	microbench.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	microbenchmarks of small hot functions, added on October 18, 2026
+
+	each benchmark runs its function on a fixed set of inputs. iterations
+	are doubled until a repetition lasts at least -time ms, then after
+	-warmup repetitions -repetitions are timed and min, 10th percentile,
+	median and 90th percentile of ns per call are printed, with the
+	median ns per item (window row, sample or field) where it makes sense.
+
+	gfmds.c is included so that the static gapfill() can be timed on a
+	single window, without the cascade around it
+*/
+
+/* includes */
+#include "../src/gfmds.c"
+#include <math.h>
+#include "../src/format.h"
+#if defined (_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* constants */
+#define ROWS_COUNT			17568		/* halfhourly 2004 */
+#define YEAR				2004
+#define INPUTS_COUNT		1024
+#define SCAN_ROWS_COUNT		256
+#define REPETITIONS_MAX		1000
+#if defined (_WIN32)
+#define NULL_DEVICE			"NUL"
+#else
+#define NULL_DEVICE			"/dev/null"
+#endif
+
+/* structures */
+typedef struct {
+	PREC tofill;
+	PREC driver1;
+	PREC driver2a;
+	PREC driver2b;
+} BENCH_ROW;
+
+/* f runs iterations calls and returns items processed */
+typedef struct {
+	const char *name;
+	double (*f)(const int a, const int b, const int iterations);
+	int a;
+	int b;
+} BENCH;
+
+/* */
+static const char usage[] =	"microbench times small functions of gf_mds\n\n"
+							"  -filter=text -> run only benchmarks whose name contains text\n"
+							"  -repetitions=value -> timed repetitions (default: %d)\n"
+							"  -warmup=value -> repetitions before timing (default: %d)\n"
+							"  -time=value -> minimum ms of a repetition (default: %d)\n\n";
+static const char err_arg_needs_param[] = "%s parameter not specified.\n\n";
+static const char err_unable_convert_value[] = "unable to convert value \"%s\" for %s.\n\n";
+static const char err_unable_open_null_device[] = "unable to open " NULL_DEVICE ".\n";
+
+/* */
+static char *filter = NULL;
+static int repetitions = 15;
+static int warmup = 3;
+static int min_time = 10;
+static BENCH_ROW bench_rows[ROWS_COUNT];
+static GF_ROW gf_rows[ROWS_COUNT];
+static GFMDS_COLUMN columns[GFMDS_COLUMNS];
+static int scan_rows[SCAN_ROWS_COUNT];
+static char strings[INPUTS_COUNT][32];
+static char timestamps[INPUTS_COUNT][TIMESTAMP_STRING_SIZE];
+static TIMESTAMP parsed_timestamps[INPUTS_COUNT];
+static PREC values[INPUTS_COUNT];
+static FILE *null_device;
+static volatile double sink;
+static unsigned long long random_state = 0x9E3779B97F4A7C15ULL;
+
+/* */
+static double get_time(void) {
+#if defined (_WIN32)
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart / frequency.QuadPart;
+#else
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+#endif
+}
+
+/* xorshift64*, same inputs on every run */
+static double get_random(void) {
+	random_state ^= random_state >> 12;
+	random_state ^= random_state << 25;
+	random_state ^= random_state >> 27;
+	return ((random_state * 2685821657736338717ULL) >> 11) * (1. / 9007199254740992.);
+}
+
+/* one year of halfhourly rows with daily cycles, 30% of tofill and 1% of drivers missing */
+static void build_inputs(void) {
+	int i;
+	double hour;
+	double season;
+	GFMDS_PARAMS params;
+
+	for ( i = 0; i < ROWS_COUNT; i++ ) {
+		hour = (i % 48) / 2.;
+		season = sin(3.14159265358979 * (i / 48) / 366.);
+		bench_rows[i].driver1 = 900. * season * sin(3.14159265358979 * (hour - 6.) / 12.);
+		if ( bench_rows[i].driver1 < 0. ) bench_rows[i].driver1 = 0.;
+		bench_rows[i].driver1 += 50. * get_random();
+		bench_rows[i].driver2a = 20. * season + 5. * sin(3.14159265358979 * (hour - 9.) / 12.) + 2. * get_random();
+		bench_rows[i].driver2b = 8. * season + 4. * get_random();
+		bench_rows[i].tofill = 2. - 0.02 * bench_rows[i].driver1 + 3. * get_random();
+		if ( get_random() < 0.01 ) bench_rows[i].driver1 = INVALID_VALUE;
+		if ( get_random() < 0.01 ) bench_rows[i].driver2a = INVALID_VALUE;
+		if ( get_random() < 0.01 ) bench_rows[i].driver2b = INVALID_VALUE;
+		if ( get_random() < 0.3 ) bench_rows[i].tofill = INVALID_VALUE;
+	}
+
+	memset(columns, 0, sizeof columns);
+	columns[GFMDS_COLUMN_TOFILL].values = &bench_rows[0].tofill;
+	columns[GFMDS_COLUMN_DRIVER1].values = &bench_rows[0].driver1;
+	columns[GFMDS_COLUMN_DRIVER2A].values = &bench_rows[0].driver2a;
+	columns[GFMDS_COLUMN_DRIVER2B].values = &bench_rows[0].driver2b;
+	columns[GFMDS_COLUMN_TOFILL].stride = sizeof(BENCH_ROW);
+	columns[GFMDS_COLUMN_DRIVER1].stride = sizeof(BENCH_ROW);
+	columns[GFMDS_COLUMN_DRIVER2A].stride = sizeof(BENCH_ROW);
+	columns[GFMDS_COLUMN_DRIVER2B].stride = sizeof(BENCH_ROW);
+	gfmds_params_default(&params);
+	set_masks(&params, columns, ROWS_COUNT, gf_rows, 0, ROWS_COUNT);
+
+	/* rows to fill are in the middle of the year, with all drivers */
+	for ( i = 0; i < SCAN_ROWS_COUNT; i++ ) {
+		scan_rows[i] = ROWS_COUNT / 2 + i * 7;
+		while ( !IS_FLAG_SET(gf_rows[scan_rows[i]].mask, GF_VALUE1_VALID|GF_VALUE2_VALID|GF_VALUE3_VALID) ) {
+			++scan_rows[i];
+		}
+	}
+
+	for ( i = 0; i < INPUTS_COUNT; i++ ) {
+		values[i] = bench_rows[i*17].tofill;
+		if ( IS_INVALID_VALUE(values[i]) ) {
+			sprintf(strings[i], "%d", (int)INVALID_VALUE);
+		} else {
+			sprintf(strings[i], "%g", values[i]);
+		}
+		timestamp_get_by_row_s_r(i*17, YEAR, HALFHOURLY_TIMERES, 1, timestamps[i]);
+		timestamp_get_by_row_r(i*17, YEAR, HALFHOURLY_TIMERES, 1, &parsed_timestamps[i]);
+	}
+}
+
+/* */
+static double bench_convert_string_to_prec(const int a, const int b, const int iterations) {
+	int i;
+	int error;
+	PREC sum;
+
+	sum = 0.;
+	for ( i = 0; i < iterations; i++ ) {
+		sum += convert_string_to_prec(strings[i & (INPUTS_COUNT-1)], &error);
+	}
+	sink = sum;
+	return iterations;
+}
+
+/* */
+static double bench_get_timestamp(const int a, const int b, const int iterations) {
+	int i;
+	int sum;
+	TIMESTAMP *t;
+
+	sum = 0;
+	for ( i = 0; i < iterations; i++ ) {
+		t = get_timestamp(timestamps[i & (INPUTS_COUNT-1)]);
+		if ( t ) {
+			sum += t->mm;
+			free(t);
+		}
+	}
+	sink = sum;
+	return iterations;
+}
+
+/* */
+static double bench_get_row_by_timestamp(const int a, const int b, const int iterations) {
+	int i;
+	int sum;
+
+	sum = 0;
+	for ( i = 0; i < iterations; i++ ) {
+		sum += get_row_by_timestamp(&parsed_timestamps[i & (INPUTS_COUNT-1)], HALFHOURLY_TIMERES);
+	}
+	sink = sum;
+	return iterations;
+}
+
+/* */
+static double bench_timestamp_get_by_row_s(const int a, const int b, const int iterations) {
+	int i;
+	int sum;
+
+	sum = 0;
+	for ( i = 0; i < iterations; i++ ) {
+		sum += timestamp_get_by_row_s((i * 17) % ROWS_COUNT, YEAR, HALFHOURLY_TIMERES, 1)[11];
+	}
+	sink = sum;
+	return iterations;
+}
+
+/* a is samples count */
+static double bench_standard_deviation(const int a, const int b, const int iterations) {
+	int i;
+	PREC sum;
+
+	for ( i = 0; i < a; i++ ) {
+		gf_rows[i].similiar = values[i & (INPUTS_COUNT-1)];
+	}
+	sum = 0.;
+	for ( i = 0; i < iterations; i++ ) {
+		sum += gf_get_similiar_standard_deviation(gf_rows, a);
+	}
+	sink = sum;
+	return (double)a * iterations;
+}
+
+/* a is samples count */
+static double bench_median(const int a, const int b, const int iterations) {
+	int i;
+	int error;
+	PREC sum;
+
+	for ( i = 0; i < a; i++ ) {
+		gf_rows[i].similiar = values[i & (INPUTS_COUNT-1)];
+	}
+	sum = 0.;
+	for ( i = 0; i < iterations; i++ ) {
+		sum += gf_get_similiar_median(gf_rows, a, &error);
+	}
+	sink = sum;
+	return (double)a * iterations;
+}
+
+/* a is method, b is window in days, items are window rows scanned */
+static double bench_gapfill(const int a, const int b, const int iterations) {
+	int i;
+	int sum;
+	COUNTERS counters;
+
+	counters.work = 0;
+	counters.candidates = 0;
+	sum = 0;
+	for ( i = 0; i < iterations; i++ ) {
+		sum += gapfill(	columns,
+						gf_rows,
+						0,
+						ROWS_COUNT,
+						scan_rows[i & (SCAN_ROWS_COUNT-1)],
+						b,
+						b,
+						1,
+						a,
+						HALFHOURLY_TIMERES,
+						GF_DRIVER_1_TOLERANCE_MIN,
+						GF_DRIVER_1_TOLERANCE_MAX,
+						GF_DRIVER_2A_TOLERANCE_MIN,
+						GF_DRIVER_2A_TOLERANCE_MAX,
+						GF_DRIVER_2B_TOLERANCE_MIN,
+						GF_DRIVER_2B_TOLERANCE_MAX,
+						&counters
+		);
+	}
+	sink = sum;
+	return counters.work;
+}
+
+/* */
+static double bench_format_double(const int a, const int b, const int iterations) {
+	int i;
+	int sum;
+	char buffer[32];
+
+	sum = 0;
+	for ( i = 0; i < iterations; i++ ) {
+		sum += format_double(buffer, values[i & (INPUTS_COUNT-1)]);
+	}
+	sink = sum;
+	return iterations;
+}
+
+/* the printf path replaced by format_double */
+static double bench_sprintf_double(const int a, const int b, const int iterations) {
+	int i;
+	int sum;
+	char buffer[32];
+
+	sum = 0;
+	for ( i = 0; i < iterations; i++ ) {
+		sum += sprintf(buffer, "%g", values[i & (INPUTS_COUNT-1)]);
+	}
+	sink = sum;
+	return iterations;
+}
+
+/* output row as written by output.c, items are fields */
+static double bench_output_row_format(const int a, const int b, const int iterations) {
+	int i;
+	int j;
+	char buffer[256];
+	char *p;
+
+	for ( i = 0; i < iterations; i++ ) {
+		j = i & (INPUTS_COUNT-1);
+		p = buffer;
+		p += format_timestamp(p, &parsed_timestamps[j]);
+		*p++ = ',';
+		p += format_double(p, values[j]);
+		*p++ = ',';
+		p += format_double(p, values[(j+1) & (INPUTS_COUNT-1)]);
+		*p++ = ',';
+		p += format_int(p, j & 3);
+		*p++ = ',';
+		p += format_double(p, values[(j+2) & (INPUTS_COUNT-1)]);
+		*p++ = ',';
+		p += format_int(p, j);
+		*p++ = ',';
+		p += format_double(p, values[(j+3) & (INPUTS_COUNT-1)]);
+		*p++ = ',';
+		p += format_int(p, (j & 1) + 1);
+		*p++ = ',';
+		p += format_int(p, j & 1);
+		*p++ = ',';
+		p += format_int(p, 14);
+		*p++ = '\n';
+		fwrite(buffer, 1, p - buffer, null_device);
+	}
+	return 10. * iterations;
+}
+
+/* same row through fprintf, as written before format.c */
+static double bench_output_row_fprintf(const int a, const int b, const int iterations) {
+	int i;
+	int j;
+
+	for ( i = 0; i < iterations; i++ ) {
+		j = i & (INPUTS_COUNT-1);
+		fprintf(null_device, "%s,%g,%g,%d,%g,%d,%g,%d,%d,%d\n",
+						timestamps[j],
+						values[j],
+						values[(j+1) & (INPUTS_COUNT-1)],
+						j & 3,
+						values[(j+2) & (INPUTS_COUNT-1)],
+						j,
+						values[(j+3) & (INPUTS_COUNT-1)],
+						(j & 1) + 1,
+						j & 1,
+						14
+		);
+	}
+	return 10. * iterations;
+}
+
+/* */
+static const BENCH benchs[] = {
+	{ "convert_string_to_prec", bench_convert_string_to_prec, 0, 0 },
+	{ "get_timestamp", bench_get_timestamp, 0, 0 },
+	{ "get_row_by_timestamp", bench_get_row_by_timestamp, 0, 0 },
+	{ "timestamp_get_by_row_s", bench_timestamp_get_by_row_s, 0, 0 },
+	{ "standard_deviation 10", bench_standard_deviation, 10, 0 },
+	{ "standard_deviation 100", bench_standard_deviation, 100, 0 },
+	{ "standard_deviation 1000", bench_standard_deviation, 1000, 0 },
+	{ "median 10", bench_median, 10, 0 },
+	{ "median 100", bench_median, 100, 0 },
+	{ "median 1000", bench_median, 1000, 0 },
+	{ "gapfill all 7 days", bench_gapfill, GF_ALL_METHOD, 7 },
+	{ "gapfill all 14 days", bench_gapfill, GF_ALL_METHOD, 14 },
+	{ "gapfill all 28 days", bench_gapfill, GF_ALL_METHOD, 28 },
+	{ "gapfill all 56 days", bench_gapfill, GF_ALL_METHOD, 56 },
+	{ "gapfill driver1 7 days", bench_gapfill, GF_VALUE1_METHOD, 7 },
+	{ "gapfill driver1 14 days", bench_gapfill, GF_VALUE1_METHOD, 14 },
+	{ "gapfill driver1 28 days", bench_gapfill, GF_VALUE1_METHOD, 28 },
+	{ "gapfill driver1 56 days", bench_gapfill, GF_VALUE1_METHOD, 56 },
+	{ "gapfill tofill 0 days", bench_gapfill, GF_TOFILL_METHOD, 0 },
+	{ "gapfill tofill 1 day", bench_gapfill, GF_TOFILL_METHOD, 1 },
+	{ "gapfill tofill 2 days", bench_gapfill, GF_TOFILL_METHOD, 2 },
+	{ "gapfill tofill 7 days", bench_gapfill, GF_TOFILL_METHOD, 7 },
+	{ "format_double", bench_format_double, 0, 0 },
+	{ "sprintf %g", bench_sprintf_double, 0, 0 },
+	{ "output row format.c", bench_output_row_format, 0, 0 },
+	{ "output row fprintf", bench_output_row_fprintf, 0, 0 },
+};
+
+/* */
+static int compare_double(const void *a, const void *b) {
+	if ( *(const double *)a < *(const double *)b ) {
+		return -1;
+	} else if ( *(const double *)a > *(const double *)b ) {
+		return 1;
+	}
+	return 0;
+}
+
+/* nearest rank */
+static double get_percentile(const double *const times, const int count, const int percentile) {
+	int i;
+
+	i = (percentile * count + 99) / 100 - 1;
+	if ( i < 0 ) {
+		i = 0;
+	}
+	return times[i];
+}
+
+/* */
+static void run_bench(const BENCH *const bench) {
+	int i;
+	int iterations;
+	double time;
+	double items;
+	double times[REPETITIONS_MAX];
+	double items_time;
+
+	/* calibrate */
+	iterations = 1;
+	for ( ; ; ) {
+		time = get_time();
+		bench->f(bench->a, bench->b, iterations);
+		time = get_time() - time;
+		if ( (time * 1000. >= min_time) || (iterations >= (1 << 30)) ) {
+			break;
+		}
+		iterations *= 2;
+	}
+
+	for ( i = 0; i < warmup; i++ ) {
+		bench->f(bench->a, bench->b, iterations);
+	}
+
+	items = 0.;
+	for ( i = 0; i < repetitions; i++ ) {
+		time = get_time();
+		items = bench->f(bench->a, bench->b, iterations);
+		times[i] = (get_time() - time) * 1e9 / iterations;
+	}
+	qsort(times, repetitions, sizeof *times, compare_double);
+
+	printf("%-26s %10d %10.1f %10.1f %10.1f %10.1f", bench->name, iterations,
+				times[0],
+				get_percentile(times, repetitions, 10),
+				get_percentile(times, repetitions, 50),
+				get_percentile(times, repetitions, 90)
+	);
+	items_time = get_percentile(times, repetitions, 50) * iterations / items;
+	if ( (items > 0.) && (items != iterations) ) {
+		printf(" %10.3f", items_time);
+	}
+	putchar('\n');
+}
+
+/* */
+static int set_string(char *arg, char *param, void *p) {
+	if ( !param || !param[0] ) {
+		printf(err_arg_needs_param, arg);
+		return 0;
+	}
+	*(char **)p = param;
+	return 1;
+}
+
+/* */
+static int set_int(char *arg, char *param, void *p) {
+	int error;
+	int value;
+
+	if ( !param ) {
+		printf(err_arg_needs_param, arg);
+		return 0;
+	}
+	value = convert_string_to_int(param, &error);
+	if ( error || (value < 0) || (value > REPETITIONS_MAX) ) {
+		printf(err_unable_convert_value, param, arg);
+		return 0;
+	}
+	*(int *)p = value;
+	return 1;
+}
+
+/* */
+static int show_help(char *arg, char *param, void *p) {
+	printf(usage, repetitions, warmup, min_time);
+	exit(0);
+	return 0;
+}
+
+/* */
+int main(int argc, char *argv[]) {
+	int i;
+
+	const ARGUMENT args[] = {
+		{ "filter", set_string, &filter },
+		{ "repetitions", set_int, &repetitions },
+		{ "warmup", set_int, &warmup },
+		{ "time", set_int, &min_time },
+		{ "h", show_help, NULL },
+		{ "?", show_help, NULL },
+		{ "help", show_help, NULL },
+	};
+
+	if ( !parse_arguments(argc, argv, args, SIZEOF_ARRAY(args)) ) {
+		return 1;
+	}
+	if ( !repetitions ) {
+		repetitions = 1;
+	}
+
+	null_device = fopen(NULL_DEVICE, "w");
+	if ( !null_device ) {
+		puts(err_unable_open_null_device);
+		return 1;
+	}
+	build_inputs();
+
+	printf("%-26s %10s %10s %10s %10s %10s %10s\n", "ns per call", "calls", "min", "p10", "median", "p90", "per item");
+	for ( i = 0; i < SIZEOF_ARRAY(benchs); i++ ) {
+		if ( !filter || strstr(benchs[i].name, filter) ) {
+			run_bench(&benchs[i]);
+		}
+	}
+	fclose(null_device);
+
+	return 0;
+}
@@ -0,0 +1,87 @@
+#!/bin/sh
+#
+# verify.sh, randomized check of the engine against the reference engine,
+# added on October 18, 2026
+#
+# this file is part of gf_mds
+#
+# run by "make verify": each run writes one or two synthetic datasets with
+# random time resolution, years (leap ones too), first day, share of gaps,
+# missing drivers and drivers left empty, then gapfills them with
+# gf_mds -verify. datasets of runs that differ are kept in VERIFY_DIR.
+#
+# environment: VERIFY_RUNS (default: 20), VERIFY_SEED (default: 1),
+# VERIFY_DIR (default: verify_out), GF_MDS (default: ./gf_mds),
+# GEN_DATASET (default: ./gen_dataset)
+
+VERIFY_RUNS=${VERIFY_RUNS:-20}
+VERIFY_SEED=${VERIFY_SEED:-1}
+VERIFY_DIR=${VERIFY_DIR:-verify_out}
+GF_MDS=${GF_MDS:-./gf_mds}
+GEN_DATASET=${GEN_DATASET:-./gen_dataset}
+
+if [ ! -x "$GF_MDS" ] || [ ! -x "$GEN_DATASET" ]; then
+	echo "$GF_MDS or $GEN_DATASET not found, use make verify"
+	exit 1
+fi
+mkdir -p "$VERIFY_DIR" || exit 1
+
+FAILED=0
+RUN=1
+while [ $RUN -le $VERIFY_RUNS ]; do
+	SEED=$((VERIFY_SEED + RUN))
+
+	# timeres years year first_day gaps driver_gaps missing split
+	set -- $(awk -v seed=$SEED 'BEGIN {
+		srand(seed)
+		split("15 30 30 60", timeres, " ")
+		split("0.05 0.3 0.6 0.9", gaps, " ")
+		split("0 0.01 0.2 1", driver_gaps, " ")
+		split("- - - - SW_IN TA VPD all", missing, " ")
+		t = timeres[int(rand() * 4) + 1]
+		years = int(rand() * ((15 == t) ? 2 : 3)) + 1
+		first_day = (rand() < 0.5) ? 1 : int(rand() * 365) + 1
+		printf "%d %d %d %d %s %s %s %d\n", t, years, 1999 + int(rand() * 14), first_day,
+					gaps[int(rand() * 4) + 1], driver_gaps[int(rand() * 4) + 1], missing[int(rand() * 8) + 1],
+					(years > 1) && (rand() < 0.5)
+	}')
+	TIMERES=$1; YEARS=$2; YEAR=$3; FIRST_DAY=$4; GAPS=$5; DRIVER_GAPS=$6; MISSING=$7; SPLIT=$8
+
+	case $MISSING in
+		-) MISSING_ARGS="" ;;
+		all) MISSING_ARGS="-missing=SW_IN -missing=TA -missing=VPD" ;;
+		*) MISSING_ARGS="-missing=$MISSING" ;;
+	esac
+	case $TIMERES in
+		15) FLAGS="-quaterhourly" ;;
+		60) FLAGS="-hourly" ;;
+		*) FLAGS="" ;;
+	esac
+
+	# a dataset of more years is written in one file or split in two files joined with +
+	NAME="run$RUN"
+	ARGS="-timeres=$TIMERES -gaps=$GAPS -driver_gaps=$DRIVER_GAPS $MISSING_ARGS -seed=$SEED"
+	if [ $SPLIT -eq 1 ]; then
+		"$GEN_DATASET" -output="$VERIFY_DIR/${NAME}a.csv" $ARGS -year=$YEAR -first_day=$FIRST_DAY || exit 1
+		"$GEN_DATASET" -output="$VERIFY_DIR/${NAME}b.csv" $ARGS -year=$((YEAR + 1)) -years=$((YEARS - 1)) || exit 1
+		INPUT="$VERIFY_DIR/${NAME}a.csv+$VERIFY_DIR/${NAME}b.csv"
+	else
+		"$GEN_DATASET" -output="$VERIFY_DIR/$NAME.csv" $ARGS -year=$YEAR -years=$YEARS -first_day=$FIRST_DAY || exit 1
+		INPUT="$VERIFY_DIR/$NAME.csv"
+	fi
+
+	DESCRIPTION="timeres $TIMERES, $YEARS years from $YEAR day $FIRST_DAY, gaps $GAPS, driver gaps $DRIVER_GAPS, missing $MISSING, split $SPLIT"
+	"$GF_MDS" -input="$INPUT" -output="$VERIFY_DIR/" $FLAGS -verify > "$VERIFY_DIR/$NAME.log"
+	if [ $? -ne 0 ] || ! grep -q "^verify: same results" "$VERIFY_DIR/$NAME.log"; then
+		echo "run $RUN ($DESCRIPTION): FAILED, see $VERIFY_DIR/$NAME.log"
+		grep "^verify\|^  " "$VERIFY_DIR/$NAME.log"
+		FAILED=$((FAILED + 1))
+	else
+		echo "run $RUN ($DESCRIPTION): ok"
+		rm -f "$VERIFY_DIR/$NAME"*
+	fi
+	RUN=$((RUN + 1))
+done
+
+echo "$FAILED of $VERIFY_RUNS runs differ from reference engine"
+[ $FAILED -eq 0 ]
@@ -0,0 +1,402 @@
+/*
+	gfmds_module.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	python extension of the gapfilling engine, added on October 18, 2026
+
+	gfmds.fill(values, ...) reads any buffer of doubles (numpy arrays,
+	array.array, memoryview...) without copying it:
+
+	- a 2d buffer is read by its strides, so rows can be interleaved
+	  (C order) or columns contiguous (Fortran order), column arguments
+	  are indexes of the second dimension.
+	- a 1d contiguous buffer needs struct_size (bytes between rows) and
+	  columns are indexes of doubles from the start of a row, as in
+	  gfmds_fill. rows_count defaults to the rows in the buffer, set it
+	  for columns one after the other (struct_size=8, column c at
+	  c*rows_count).
+
+	the gil is released while filling. results are returned in a dict of
+	memoryviews over new buffers (filled, stddev as doubles, quality,
+	method, time_window, samples_count as ints, gap as bytes) with
+	no_gaps_filled_count.
+
+	build with "make python-module" (see setup.py)
+*/
+
+/* includes */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <limits.h>
+#include "gfmds.h"
+
+/* error strings */
+static const char err_format[] = "values must be a buffer of doubles";
+static const char err_dimensions[] = "values must have one or two dimensions";
+static const char err_struct_size_1d[] = "struct_size is required for one dimension values";
+static const char err_struct_size_2d[] = "struct_size and rows_count can't be used with two dimensions values";
+static const char err_strides[] = "values strides must be positive multiples of 8";
+static const char err_column[] = "column %d is out of values";
+static const char err_too_big[] = "values are too big";
+
+/* result columns */
+enum {
+	COLUMN_FILLED = 0,
+	COLUMN_STDDEV,
+	COLUMN_QUALITY,
+	COLUMN_METHOD,
+	COLUMN_TIME_WINDOW,
+	COLUMN_SAMPLES_COUNT,
+	COLUMN_GAP,
+
+	COLUMNS_COUNT
+};
+
+/* structures */
+typedef struct {
+	const char *name;
+	const char *format;
+	int size;
+} COLUMN;
+
+/* */
+static const COLUMN columns[COLUMNS_COUNT] = {
+	{ "filled", "d", sizeof(double) },
+	{ "stddev", "d", sizeof(double) },
+	{ "quality", "i", sizeof(int) },
+	{ "method", "i", sizeof(int) },
+	{ "time_window", "i", sizeof(int) },
+	{ "samples_count", "i", sizeof(int) },
+	{ "gap", "B", sizeof(unsigned char) },
+};
+
+/* */
+static int is_double_format(const char *const format) {
+	if ( !format ) {
+		return 0;
+	}
+	if ( ('@' == format[0]) || ('=' == format[0]) ) {
+		return !strcmp(format+1, "d");
+	}
+
+	return !strcmp(format, "d");
+}
+
+/* returns a memoryview over a new buffer with column of rows */
+static PyObject *new_column(const int column, const GFMDS_ROW *const rows, const int rows_count) {
+	int i;
+	char *p;
+	PyObject *buffer;
+	PyObject *view;
+	PyObject *result;
+
+	buffer = PyByteArray_FromStringAndSize(NULL, (Py_ssize_t)rows_count*columns[column].size);
+	if ( !buffer ) {
+		return NULL;
+	}
+	p = PyByteArray_AS_STRING(buffer);
+	for ( i = 0; i < rows_count; i++ ) {
+		switch ( column ) {
+			case COLUMN_FILLED:
+				((double *)p)[i] = rows[i].filled;
+			break;
+
+			case COLUMN_STDDEV:
+				((double *)p)[i] = rows[i].stddev;
+			break;
+
+			case COLUMN_QUALITY:
+				((int *)p)[i] = rows[i].quality;
+			break;
+
+			case COLUMN_METHOD:
+				((int *)p)[i] = rows[i].method;
+			break;
+
+			case COLUMN_TIME_WINDOW:
+				((int *)p)[i] = rows[i].time_window;
+			break;
+
+			case COLUMN_SAMPLES_COUNT:
+				((int *)p)[i] = rows[i].samples_count;
+			break;
+
+			case COLUMN_GAP:
+				((unsigned char *)p)[i] = !(rows[i].mask & GFMDS_TOFILL_VALID);
+			break;
+		}
+	}
+
+	view = PyMemoryView_FromObject(buffer);
+	Py_DECREF(buffer);
+	if ( !view ) {
+		return NULL;
+	}
+	result = PyObject_CallMethod(view, "cast", "s", columns[column].format);
+	Py_DECREF(view);
+
+	return result;
+}
+
+/*
+	sets struct_size and scales columns of params for values layout.
+	returns rows count or -1 on error (exception is set)
+*/
+static int set_layout(const Py_buffer *const view, GFMDS_PARAMS *const params, int *const struct_size, int rows_count) {
+	int i;
+	Py_ssize_t step;
+	Py_ssize_t end;
+	int *const p[] = {
+		&params->tofill_column,
+		&params->driver1_column,
+		&params->driver2a_column,
+		&params->driver2b_column,
+		&params->driver1_qc_column,
+		&params->driver2a_qc_column,
+		&params->driver2b_qc_column,
+	};
+
+	if ( !is_double_format(view->format) || (sizeof(double) != view->itemsize) ) {
+		PyErr_SetString(PyExc_TypeError, err_format);
+		return -1;
+	}
+
+	if ( 1 == view->ndim ) {
+		if ( *struct_size <= 0 ) {
+			PyErr_SetString(PyExc_ValueError, err_struct_size_1d);
+			return -1;
+		}
+		if ( view->strides[0] != view->itemsize ) {
+			PyErr_SetString(PyExc_ValueError, err_strides);
+			return -1;
+		}
+		if ( (*struct_size % sizeof(double)) || (view->len / *struct_size > INT_MAX) ) {
+			PyErr_SetString(PyExc_ValueError, (*struct_size % sizeof(double)) ? err_strides : err_too_big);
+			return -1;
+		}
+		if ( (rows_count <= 0) || (rows_count > view->len / *struct_size) ) {
+			rows_count = (int)(view->len / *struct_size);
+		}
+
+		/* every column must be inside the buffer on the last row */
+		for ( i = 0; i < (int)(sizeof(p)/sizeof(p[0])); i++ ) {
+			end = (Py_ssize_t)(rows_count-1)*(*struct_size) + (Py_ssize_t)(*p[i]+1)*sizeof(double);
+			if ( (*p[i] >= 0) && (end > view->len) ) {
+				PyErr_Format(PyExc_ValueError, err_column, *p[i]);
+				return -1;
+			}
+		}
+	} else if ( 2 == view->ndim ) {
+		if ( (*struct_size > 0) || (rows_count > 0) ) {
+			PyErr_SetString(PyExc_ValueError, err_struct_size_2d);
+			return -1;
+		}
+		if (	(view->strides[0] <= 0) || (view->strides[1] <= 0)
+				|| (view->strides[0] % sizeof(double)) || (view->strides[1] % sizeof(double)) ) {
+			PyErr_SetString(PyExc_ValueError, err_strides);
+			return -1;
+		}
+		if ( (view->shape[0] > INT_MAX) || (view->strides[0] > INT_MAX) ) {
+			PyErr_SetString(PyExc_ValueError, err_too_big);
+			return -1;
+		}
+		rows_count = (int)view->shape[0];
+		*struct_size = (int)view->strides[0];
+
+		/* element (row, column) is at row*strides[0] + column*strides[1] */
+		step = view->strides[1] / sizeof(double);
+		for ( i = 0; i < (int)(sizeof(p)/sizeof(p[0])); i++ ) {
+			if ( *p[i] < 0 ) {
+				continue;
+			}
+			if ( *p[i] >= view->shape[1] ) {
+				PyErr_Format(PyExc_ValueError, err_column, *p[i]);
+				return -1;
+			}
+			if ( *p[i]*step > INT_MAX ) {
+				PyErr_SetString(PyExc_ValueError, err_too_big);
+				return -1;
+			}
+			*p[i] = (int)(*p[i]*step);
+		}
+	} else {
+		PyErr_SetString(PyExc_ValueError, err_dimensions);
+		return -1;
+	}
+
+	return rows_count;
+}
+
+/* */
+static PyObject *fill(PyObject *self, PyObject *args, PyObject *kwargs) {
+	int i;
+	int error;
+	int rows_count;
+	int struct_size;
+	int no_gaps_filled_count;
+	PyObject *values;
+	PyObject *result;
+	PyObject *column;
+	Py_buffer view;
+	GFMDS_ROW *rows;
+	GFMDS_PARAMS params;
+	GFMDS_CONTEXT *context;
+	static char *keywords[] = {
+		"values", "struct_size", "rows_count", "timeres",
+		"tofill", "driver1", "driver2a", "driver2b",
+		"driver1_qc", "driver2a_qc", "driver2b_qc", "qc_thrs",
+		"driver1_tolerance_min", "driver1_tolerance_max",
+		"driver2a_tolerance_min", "driver2a_tolerance_max",
+		"driver2b_tolerance_min", "driver2b_tolerance_max",
+		"values_min", "compute_hat", "start_row", "end_row",
+		NULL
+	};
+
+	(void)self;
+
+	struct_size = 0;
+	rows_count = 0;
+	gfmds_params_default(&params);
+	if ( !PyArg_ParseTupleAndKeywords(args, kwargs, "O|$iiiiiiiiiiiddddddipii", keywords
+										, &values, &struct_size, &rows_count, &params.timeres
+										, &params.tofill_column, &params.driver1_column, &params.driver2a_column, &params.driver2b_column
+										, &params.driver1_qc_column, &params.driver2a_qc_column, &params.driver2b_qc_column, &params.qc_thrs
+										, &params.driver1_tolerance_min, &params.driver1_tolerance_max
+										, &params.driver2a_tolerance_min, &params.driver2a_tolerance_max
+										, &params.driver2b_tolerance_min, &params.driver2b_tolerance_max
+										, &params.values_min, &params.compute_hat, &params.start_row, &params.end_row) ) {
+		return NULL;
+	}
+
+	/* no copy of values, buffer can't be resized until released */
+	if ( PyObject_GetBuffer(values, &view, PyBUF_STRIDES | PyBUF_FORMAT) < 0 ) {
+		return NULL;
+	}
+	rows_count = set_layout(&view, &params, &struct_size, rows_count);
+	if ( rows_count < 0 ) {
+		PyBuffer_Release(&view);
+		return NULL;
+	}
+	if ( !rows_count ) {
+		PyBuffer_Release(&view);
+		PyErr_SetString(PyExc_ValueError, gfmds_get_error_string(GFMDS_ERR_PARAMS));
+		return NULL;
+	}
+
+	rows = PyMem_RawMalloc((size_t)rows_count*sizeof*rows);
+	context = gfmds_create(&params);
+	if ( !rows || !context ) {
+		gfmds_destroy(context);
+		PyMem_RawFree(rows);
+		PyBuffer_Release(&view);
+		return PyErr_NoMemory();
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	error = gfmds_fill(context, view.buf, struct_size, rows_count, rows);
+	Py_END_ALLOW_THREADS
+
+	no_gaps_filled_count = gfmds_get_no_gaps_filled_count(context);
+	gfmds_destroy(context);
+	PyBuffer_Release(&view);
+
+	if ( GFMDS_OK != error ) {
+		PyMem_RawFree(rows);
+		if ( GFMDS_ERR_OUT_OF_MEMORY == error ) {
+			return PyErr_NoMemory();
+		}
+		PyErr_SetString(PyExc_ValueError, gfmds_get_error_string(error));
+		return NULL;
+	}
+
+	/* results */
+	result = PyDict_New();
+	if ( !result ) {
+		PyMem_RawFree(rows);
+		return NULL;
+	}
+	for ( i = 0; i < COLUMNS_COUNT; i++ ) {
+		column = new_column(i, rows, rows_count);
+		if ( !column || (PyDict_SetItemString(result, columns[i].name, column) < 0) ) {
+			Py_XDECREF(column);
+			Py_DECREF(result);
+			PyMem_RawFree(rows);
+			return NULL;
+		}
+		Py_DECREF(column);
+	}
+	PyMem_RawFree(rows);
+
+	column = PyLong_FromLong(no_gaps_filled_count);
+	if ( !column || (PyDict_SetItemString(result, "no_gaps_filled_count", column) < 0) ) {
+		Py_XDECREF(column);
+		Py_DECREF(result);
+		return NULL;
+	}
+	Py_DECREF(column);
+
+	return result;
+}
+
+/* */
+static PyMethodDef methods[] = {
+	{ "fill", (PyCFunction)(void(*)(void))fill, METH_VARARGS | METH_KEYWORDS,
+		"fill(values, *, struct_size=0, rows_count=0, timeres=HALFHOURLY, tofill=0, driver1=1, driver2a=2, driver2b=3, ...)\n\n"
+		"gapfill values with the MDS method, see gfmds_module.c for details." },
+	{ NULL, NULL, 0, NULL }
+};
+
+/* */
+static struct PyModuleDef module = {
+	PyModuleDef_HEAD_INIT,
+	"gfmds",
+	"MDS gapfilling engine (libgfmds)",
+	-1,
+	methods,
+	NULL,
+	NULL,
+	NULL,
+	NULL
+};
+
+/* */
+PyMODINIT_FUNC PyInit_gfmds(void) {
+	PyObject *m;
+
+	m = PyModule_Create(&module);
+	if ( !m ) {
+		return NULL;
+	}
+	if (	(PyModule_AddIntConstant(m, "QUATERHOURLY", GFMDS_QUATERHOURLY) < 0)
+			|| (PyModule_AddIntConstant(m, "HALFHOURLY", GFMDS_HALFHOURLY) < 0)
+			|| (PyModule_AddIntConstant(m, "HOURLY", GFMDS_HOURLY) < 0)
+			|| (PyModule_AddIntConstant(m, "INVALID_VALUE", GFMDS_INVALID_VALUE) < 0)
+			|| (PyModule_AddIntConstant(m, "VERSION", gfmds_get_version()) < 0) ) {
+		Py_DECREF(m);
+		return NULL;
+	}
+
+	return m;
+}
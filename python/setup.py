@@ -0,0 +1,19 @@
+# python extension of the gapfilling engine, added on October 18, 2026
+#
+# build in place with:  python3 setup.py build_ext --inplace
+# (or "make python-module" from the repository root)
+
+from setuptools import setup, Extension
+
+setup(
+	name='gfmds',
+	version='1.0.0',
+	description='MDS gapfilling engine (libgfmds)',
+	ext_modules=[
+		Extension(
+			'gfmds',
+			sources=['gfmds_module.c', '../src/gfmds.c'],
+			include_dirs=['../src'],
+		),
+	],
+)
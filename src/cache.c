@@ -0,0 +1,427 @@
+/*
+	cache.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	binary columnar dataset cache, added on October 18, 2026
+
+	the result of import_dataset is saved as a gfb file and memory mapped
+	on next runs, so no parsing is needed. a cache is valid only if it was
+	created with same vars, timeres and padding and if every source file
+	has the same size and the same modification time. if only the
+	modification time differs (e.g. a copied file) the content hash
+	is compared too.
+*/
+
+/* includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "cache.h"
+
+/* os dependant */
+#if defined (_WIN32)
+#ifndef STRICT
+#define STRICT
+#endif /* STRICT */
+#ifndef WIN32_MEAN_AND_LEAN
+#define WIN32_MEAN_AND_LEAN
+#endif /* WIN32_MEAN_AND_LEAN */
+#include <windows.h>
+#elif defined (linux) || defined (__linux) || defined (__linux__) || defined (__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+/* constants */
+#define CACHE_BYTE_ORDER		0x01020304
+#define CACHE_BLOCK_SIZE		(64*1024)
+#define FNV_OFFSET_BASIS		14695981039346656037ULL
+#define FNV_PRIME				1099511628211ULL
+
+/* structures */
+typedef struct {
+	const char *p;
+	long long size;
+#if defined (_WIN32)
+	HANDLE file;
+	HANDLE mapping;
+#endif
+} MAPPING;
+
+/* extern variables */
+extern int timeres;
+extern int full_years;
+extern char tokens[GF_TOKENS][GF_TOKEN_LENGTH_MAX+1];
+
+/* strings */
+static const char tmp_extension[] = ".tmp";
+
+/* error strings */
+static const char err_unable_create_cache[] = "unable to create cache file: %s\n";
+static const char err_unable_stat_source[] = "unable to get size and time of %s\n";
+
+/* extern error strings */
+extern const char err_out_of_memory[];
+
+/* */
+static int map_file(const char *const filename, MAPPING *const m) {
+#if defined (_WIN32)
+	LARGE_INTEGER size;
+
+	m->file = CreateFile(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if ( INVALID_HANDLE_VALUE == m->file ) {
+		return 0;
+	}
+	if ( !GetFileSizeEx(m->file, &size) || !size.QuadPart ) {
+		CloseHandle(m->file);
+		return 0;
+	}
+	m->size = size.QuadPart;
+	m->mapping = CreateFileMapping(m->file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if ( !m->mapping ) {
+		CloseHandle(m->file);
+		return 0;
+	}
+	m->p = MapViewOfFile(m->mapping, FILE_MAP_READ, 0, 0, 0);
+	if ( !m->p ) {
+		CloseHandle(m->mapping);
+		CloseHandle(m->file);
+		return 0;
+	}
+	return 1;
+#elif defined (linux) || defined (__linux) || defined (__linux__) || defined (__APPLE__)
+	int fd;
+	struct stat st;
+	void *p;
+
+	fd = open(filename, O_RDONLY);
+	if ( -1 == fd ) {
+		return 0;
+	}
+	if ( (-1 == fstat(fd, &st)) || !st.st_size ) {
+		close(fd);
+		return 0;
+	}
+	m->size = st.st_size;
+	p = mmap(NULL, (size_t)m->size, PROT_READ, MAP_PRIVATE, fd, 0);
+	/* mapping is still valid after close */
+	close(fd);
+	if ( MAP_FAILED == p ) {
+		return 0;
+	}
+	m->p = p;
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+/* */
+static void unmap_file(MAPPING *const m) {
+#if defined (_WIN32)
+	UnmapViewOfFile(m->p);
+	CloseHandle(m->mapping);
+	CloseHandle(m->file);
+#elif defined (linux) || defined (__linux) || defined (__linux__) || defined (__APPLE__)
+	munmap((void *)m->p, (size_t)m->size);
+#endif
+	m->p = NULL;
+}
+
+/* */
+static int get_source_stat(const char *const filename, CACHE_SOURCE *const source) {
+#if defined (_WIN32)
+	struct _stat64 st;
+
+	if ( _stat64(filename, &st) ) {
+		return 0;
+	}
+	source->mtime = (long long)st.st_mtime * 1000000000;
+#else
+	struct stat st;
+
+	if ( stat(filename, &st) ) {
+		return 0;
+	}
+#if defined (linux) || defined (__linux) || defined (__linux__)
+	source->mtime = (long long)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+#else
+	source->mtime = (long long)st.st_mtime * 1000000000;
+#endif
+#endif
+	source->size = st.st_size;
+
+	return 1;
+}
+
+/* fnv-1a 64 bit of file content */
+static int get_source_hash(const char *const filename, unsigned long long *const hash) {
+	int i;
+	int n;
+	unsigned char *buffer;
+	unsigned long long h;
+	FILE *f;
+
+	buffer = malloc(CACHE_BLOCK_SIZE);
+	if ( !buffer ) {
+		puts(err_out_of_memory);
+		return 0;
+	}
+
+	f = fopen(filename, "rb");
+	if ( !f ) {
+		free(buffer);
+		return 0;
+	}
+
+	h = FNV_OFFSET_BASIS;
+	while ( (n = (int)fread(buffer, 1, CACHE_BLOCK_SIZE, f)) > 0 ) {
+		for ( i = 0; i < n; i++ ) {
+			h ^= buffer[i];
+			h *= FNV_PRIME;
+		}
+	}
+	fclose(f);
+	free(buffer);
+
+	*hash = h;
+
+	return 1;
+}
+
+/* */
+static long long align_size(const long long size) {
+	return (size + CACHE_ALIGN - 1) / CACHE_ALIGN * CACHE_ALIGN;
+}
+
+/* */
+static int write_padding(FILE *const f, const long long size) {
+	static const char padding[CACHE_ALIGN] = { 0 };
+
+	assert((size >= 0) && (size < CACHE_ALIGN));
+
+	return !size || (1 == fwrite(padding, (size_t)size, 1, f));
+}
+
+/*
+	returns NULL if cache does not exist or is not valid
+*/
+ROW *cache_load(const char *const filename, const LIST *const list, const int list_count, CALENDAR *const calendar, char *const tofill) {
+	int i;
+	int y;
+	const PREC *column;
+	unsigned long long hash;
+	ROW *rows;
+	MAPPING m;
+	CACHE_SOURCE source;
+	const CACHE_HEADER *header;
+	const CACHE_SOURCE *sources;
+
+	assert(filename && list && calendar && tofill);
+
+	if ( !map_file(filename, &m) ) {
+		return NULL;
+	}
+
+	/* check header */
+	header = (const CACHE_HEADER *)m.p;
+	if ( (m.size < (long long)(sizeof*header + list_count*sizeof*sources))
+			|| memcmp(header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC))
+			|| (header->version != CACHE_VERSION)
+			|| (header->byte_order != CACHE_BYTE_ORDER)
+			|| (header->prec_size != sizeof(PREC))
+			|| (header->timeres != timeres)
+			|| (header->full_years != full_years)
+			|| (header->files_count != list_count)
+			|| (header->calendar.rows_count <= 0)
+			|| (header->column_size < (long long)(header->calendar.rows_count*sizeof(PREC)))
+			|| (m.size < header->columns_offset + header->column_size*GF_REQUIRED_DATASET_VALUES) ) {
+		unmap_file(&m);
+		return NULL;
+	}
+	for ( i = 0; i < GF_TOKENS; i++ ) {
+		if ( string_compare_i(header->tokens[i], tokens[i]) ) {
+			unmap_file(&m);
+			return NULL;
+		}
+	}
+
+	/* check sources */
+	sources = (const CACHE_SOURCE *)(m.p + sizeof*header);
+	for ( i = 0; i < list_count; i++ ) {
+		if ( !get_source_stat(list[i].fullpath, &source)
+				|| (source.size != sources[i].size) ) {
+			unmap_file(&m);
+			return NULL;
+		}
+		if ( source.mtime != sources[i].mtime ) {
+			if ( !get_source_hash(list[i].fullpath, &hash) || (hash != sources[i].hash) ) {
+				unmap_file(&m);
+				return NULL;
+			}
+		}
+	}
+
+	/* alloc memory */
+	rows = malloc(header->calendar.rows_count*sizeof*rows);
+	if ( !rows ) {
+		puts(err_out_of_memory);
+		unmap_file(&m);
+		return NULL;
+	}
+
+	/* get values */
+	for ( y = 0; y < GF_REQUIRED_DATASET_VALUES; y++ ) {
+		column = (const PREC *)(m.p + header->columns_offset + y*header->column_size);
+		for ( i = 0; i < header->calendar.rows_count; i++ ) {
+			rows[i].value[y] = column[i];
+		}
+	}
+	/* assigned is meaningful only while importing */
+	for ( i = 0; i < header->calendar.rows_count; i++ ) {
+		rows[i].assigned = 0;
+	}
+
+	/* use same case as input for tofill var */
+	strcpy(tofill, header->tokens[GF_TOFILL]);
+	*calendar = header->calendar;
+
+	unmap_file(&m);
+
+	return rows;
+}
+
+/* */
+int cache_save(const char *const filename, const LIST *const list, const int list_count, const ROW *const rows, const CALENDAR *const calendar, const char *const tofill) {
+	int i;
+	int j;
+	int y;
+	int n;
+	int error;
+	long long offset;
+	char *tmp_filename;
+	PREC *buffer;
+	CACHE_HEADER header;
+	CACHE_SOURCE *sources;
+	FILE *f;
+
+	assert(filename && list && rows && calendar && tofill);
+
+	/* get sources */
+	sources = malloc(list_count*sizeof*sources);
+	if ( !sources ) {
+		puts(err_out_of_memory);
+		return 0;
+	}
+	for ( i = 0; i < list_count; i++ ) {
+		if ( !get_source_stat(list[i].fullpath, &sources[i])
+				|| !get_source_hash(list[i].fullpath, &sources[i].hash) ) {
+			printf(err_unable_stat_source, list[i].fullpath);
+			free(sources);
+			return 0;
+		}
+	}
+
+	/* set header */
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	header.version = CACHE_VERSION;
+	header.byte_order = CACHE_BYTE_ORDER;
+	header.prec_size = sizeof(PREC);
+	header.timeres = timeres;
+	header.full_years = full_years;
+	header.calendar = *calendar;
+	header.files_count = list_count;
+	for ( i = 0; i < GF_TOKENS; i++ ) {
+		strcpy(header.tokens[i], (GF_TOFILL == i) ? tofill : tokens[i]);
+	}
+	header.columns_offset = align_size(sizeof(header) + list_count*sizeof*sources);
+	header.column_size = align_size(calendar->rows_count*sizeof(PREC));
+
+	/* alloc memory */
+	buffer = malloc(CACHE_BLOCK_SIZE);
+	tmp_filename = malloc(strlen(filename)+sizeof(tmp_extension));
+	if ( !buffer || !tmp_filename ) {
+		puts(err_out_of_memory);
+		free(tmp_filename);
+		free(buffer);
+		free(sources);
+		return 0;
+	}
+	sprintf(tmp_filename, "%s%s", filename, tmp_extension);
+
+	/* write to a temporary file so a broken cache is never left around */
+	f = fopen(tmp_filename, "wb");
+	if ( !f ) {
+		printf(err_unable_create_cache, filename);
+		free(tmp_filename);
+		free(buffer);
+		free(sources);
+		return 0;
+	}
+	error = (1 != fwrite(&header, sizeof(header), 1, f))
+				|| ((size_t)list_count != fwrite(sources, sizeof*sources, list_count, f));
+	free(sources);
+
+	/* write columns, each one starting at an aligned offset */
+	offset = sizeof(header) + list_count*sizeof(CACHE_SOURCE);
+	for ( y = 0; !error && (y < GF_REQUIRED_DATASET_VALUES); y++ ) {
+		error = !write_padding(f, header.columns_offset + y*header.column_size - offset);
+		for ( i = 0; !error && (i < calendar->rows_count); i += n ) {
+			n = CACHE_BLOCK_SIZE / sizeof(PREC);
+			if ( n > calendar->rows_count - i ) {
+				n = calendar->rows_count - i;
+			}
+			for ( j = 0; j < n; j++ ) {
+				buffer[j] = rows[i+j].value[y];
+			}
+			error = ((size_t)n != fwrite(buffer, sizeof(PREC), n, f));
+		}
+		offset = header.columns_offset + y*header.column_size + calendar->rows_count*sizeof(PREC);
+	}
+	if ( !error ) {
+		error = !write_padding(f, header.columns_offset + GF_REQUIRED_DATASET_VALUES*header.column_size - offset);
+	}
+	if ( fclose(f) ) {
+		error = 1;
+	}
+	free(buffer);
+
+	if ( !error ) {
+		remove(filename);
+		error = rename(tmp_filename, filename);
+	}
+	if ( error ) {
+		printf(err_unable_create_cache, filename);
+		remove(tmp_filename);
+	}
+	free(tmp_filename);
+
+	return !error;
+}
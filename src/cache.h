@@ -0,0 +1,66 @@
+/*
+	cache.h
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CACHE_H
+#define CACHE_H
+
+/* includes */
+#include "types.h"
+
+/* constants */
+#define CACHE_MAGIC				"GFB"
+#define CACHE_VERSION			1
+#define CACHE_ALIGN				64
+
+/*
+	gfb file layout: CACHE_HEADER, one CACHE_SOURCE for each imported
+	file, then GF_REQUIRED_DATASET_VALUES columns of calendar.rows_count
+	PREC values, each one starting at a CACHE_ALIGN boundary
+*/
+typedef struct {
+	char magic[4];
+	int version;
+	int byte_order;
+	int prec_size;
+	int timeres;
+	int full_years;
+	CALENDAR calendar;
+	int files_count;
+	char tokens[GF_TOKENS][GF_TOKEN_LENGTH_MAX+1];
+	long long columns_offset;
+	long long column_size;
+} CACHE_HEADER;
+
+typedef struct {
+	long long size;
+	long long mtime;
+	unsigned long long hash;
+} CACHE_SOURCE;
+
+/* prototypes */
+ROW *cache_load(const char *const filename, const LIST *const list, const int list_count, CALENDAR *const calendar, char *const tofill);
+int cache_save(const char *const filename, const LIST *const list, const int list_count, const ROW *const rows, const CALENDAR *const calendar, const char *const tofill);
+
+#endif /* CACHE_H */
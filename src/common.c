@@ -77,7 +77,6 @@ static const char err_path_too_big[] = "specified path \"%s\" is too big.\n\n";
 static const char err_filename_too_big[] = "filename \"%s\" is too big.\n\n";
 static const char err_empty_argument[] = "empty argument\n";
 static const char err_unknown_argument[] = "unknown argument: \"%s\"\n\n";
-static const char err_gf_too_less_values[] = "too few valid values to apply gapfilling\n";
 static const char err_wildcards_with_no_extension_used[] = "wildcards with no extension used\n";
 
 /* external strings */
@@ -1034,6 +1033,25 @@ int path_exists(const char *const path) {
 	return 0;
 }
 
+/* added on October 18, 2026, returns -1 on error */
+long long get_file_size(const char *const filename) {
+#if defined (_WIN32)
+	WIN32_FILE_ATTRIBUTE_DATA data;
+
+	if ( !filename || !GetFileAttributesEx(filename, GetFileExInfoStandard, &data) ) {
+		return -1;
+	}
+	return ((long long)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+#else
+	struct stat st;
+
+	if ( !filename || stat(filename, &st) ) {
+		return -1;
+	}
+	return st.st_size;
+#endif
+}
+
 /* */
 int file_exists(const char *const file) {
 #if defined (_WIN32)
@@ -1318,794 +1336,32 @@ int get_year_from_timestamp_string(const char *const string) {
 
 }
 
-/* */
+/* updated on October 18, 2026: wrapper of timestamp_get_by_row_r */
 TIMESTAMP *timestamp_get_by_row(int row, int yy, const int timeres, const int start) {
-	int i;
-	int is_leap;
-	int rows_per_day;
-	int days_per_month[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
 	static TIMESTAMP t = { 0 };
 
-	/* updated on January 17, 2018 */
-	assert((timeres > SPOT_TIMERES) && (timeres <= HOURLY_TIMERES));
-
-	/* reset */
-	t.YYYY = yy;
-	t.ss = 0;
-
-	/* leap year ? */
-	is_leap = IS_LEAP_YEAR(yy);
-	if ( is_leap ) {
-		++days_per_month[1];
-	}
-
-	/* inc row...we used 1 based index */
-	if ( ! start ) {
-		++row;
-	}
-	
-	/* compute rows per day */
-	/* updated on January 17, 2018 */
-	rows_per_day = get_rows_per_day_by_timeres(timeres);
-
-	/* get day and month */
-	t.DD = row / rows_per_day;
-	for ( i = 0, t.MM = 0; t.MM < 12; ++t.MM ) {
-		i += days_per_month[t.MM];
-		if ( t.DD <= i ) {
-			t.DD -= i - days_per_month[t.MM];
-			break;
-		}
-	}
-	if ( ++t.DD > days_per_month[t.MM] ) {
-		t.DD = 1;
-		if ( ++t.MM > 11 ) {
-			t.MM = 0;
-			++t.YYYY;
-		}
-	}
-	++t.MM;
-
-	/* get hour */
-	/* updated on January 17, 2018 */
-	if ( QUATERHOURLY_TIMERES == timeres ) {
-		// TODO
-		// CHECK THIS!
-		t.hh = (row % rows_per_day) / 4;
-		t.mm = (row % 15) * 15;
-	} else if ( HALFHOURLY_TIMERES == timeres ) {
-		t.hh = (row % rows_per_day) / 2;
-
-		/* even row ? */
-		if ( row & 1 ) {
-			t.mm = 30;
-		} else {
-			t.mm = 0;
-		}
-	} else if ( HOURLY_TIMERES == timeres ) {
-		t.hh = row % rows_per_day;
-		t.mm = 0;
-	}
-
-	/* ok */
-	return &t;
+	return timestamp_get_by_row_r(row, yy, timeres, start, &t);
 }
 
-/* updated on January 17, 2018 */
+/* updated on October 18, 2026: wrapper of timestamp_get_by_row_s_r */
 char *timestamp_get_by_row_s(int row, int yy, const int timeres, const int start) {
-	TIMESTAMP *t;
-	static char buffer[12+1] = { 0 };
-
-	assert((timeres > SPOT_TIMERES) && (timeres <= HOURLY_TIMERES));
+	static char buffer[TIMESTAMP_STRING_SIZE] = { 0 };
 
-	t = timestamp_get_by_row(row, yy, timeres, start);
-	sprintf(buffer, "%04d%02d%02d%02d%02d", t->YYYY, t->MM, t->DD, t->hh, t->mm);
-	return buffer;
+	return timestamp_get_by_row_s_r(row, yy, timeres, start, buffer);
 }
 
-/* updated on January 17, 2018 */
+/* updated on October 18, 2026: wrapper of timestamp_ww_get_by_row_r */
 TIMESTAMP *timestamp_ww_get_by_row(int row, int year, const int timeres, int start) {
-	int i;
-	int last;
-
-	/* */
-	assert((row >= 0) &&(row < 52));
-	assert((timeres > SPOT_TIMERES) && (timeres <= HOURLY_TIMERES));
-
-	/* */
-	last = (52-1 == row);
-	i = 7 * get_rows_per_day_by_timeres(timeres);
-	row *= i;
-
-	/* */
-	if ( ! start ) {
-		if ( last ) {
-			row = get_rows_count_by_timeres(timeres, year);			
-		} else {
-			row += i;
-		}
-		start = 1;
-		--row;
-	}
+	static TIMESTAMP t = { 0 };
 
-	/* */
-	return timestamp_get_by_row(row, year, timeres, start);
+	return timestamp_ww_get_by_row_r(row, year, timeres, start, &t);
 }
 
-/* updated on January 17, 2018 */
+/* updated on October 18, 2026: wrapper of timestamp_ww_get_by_row_s_r */
 char *timestamp_ww_get_by_row_s(int row, int yy, const int timeres, const int start) {
-	TIMESTAMP *t;
-	static char buffer[8+1] = { 0 };
-
-	assert((timeres > SPOT_TIMERES) && (timeres <= HOURLY_TIMERES));
-
-	t = timestamp_ww_get_by_row(row, yy, timeres, start);
-	sprintf(buffer, "%04d%02d%02d", t->YYYY, t->MM, t->DD);
-	return buffer;
-}
-
-/* private function for gapfilling */
-static PREC gf_get_similiar_mean(const GF_ROW *const gf_rows, const int rows_count) {
- 	int i;
-	PREC mean;
+	static char buffer[TIMESTAMP_WW_STRING_SIZE] = { 0 };
 
-	/* check parameter */
-	assert(gf_rows);
-
-	/* get mean */
-	mean = 0.0;
-	for ( i = 0; i < rows_count; i++ ) {
-		mean += gf_rows[i].similiar;
-	}
-	mean /= rows_count;
-
-	/* check for NAN */
-	if ( mean != mean ) {
-		mean = INVALID_VALUE;
-	}
-
-	/* */
-	return mean;
-}
-
-/* gapfilling */
-PREC gf_get_similiar_standard_deviation(const GF_ROW *const gf_rows, const int rows_count) {
-	int i;
-	PREC mean;
-	PREC sum;
-	PREC sum2;
-
-	/* check parameter */
-	assert(gf_rows);
-
-	/* get mean */
-	mean = gf_get_similiar_mean(gf_rows, rows_count);
-	if ( IS_INVALID_VALUE(mean) ) {
-		return INVALID_VALUE;
-	}
-
-	/* compute standard deviation */
-	sum = 0.0;
-	sum2 = 0.0;
-	for ( i = 0; i < rows_count; i++ ) {
-		sum = (gf_rows[i].similiar - mean);
-		sum *= sum;
-		sum2 += sum;
-	}
-	sum2 /= rows_count-1;
-	sum2 = (PREC)SQRT(sum2);
-
-	/* check for NAN */
-	if ( sum2 != sum2 ) {
-		sum2 = INVALID_VALUE;
-	}
-
-	/* */
-	return sum2;
-}
-
-/* gapfilling */
-PREC gf_get_similiar_median(const GF_ROW *const gf_rows, const int rows_count, int *const error) {
-	int i;
-	PREC *p_median;
-	PREC result;
-
-	/* check for null pointer */
-	assert(gf_rows);
-
-	/* reset */
-	*error = 0;
-
-	if ( !rows_count ) {
-		return INVALID_VALUE;
-	} else if ( 1 == rows_count ) {
-		return gf_rows[0].similiar;
-	}
-
-	/* get valid values */
-	p_median = malloc(rows_count*sizeof*p_median);
-	if ( !p_median ) {
-		*error = 1;
-		return INVALID_VALUE;
-	}
-	for ( i = 0; i < rows_count; i++ ) {
-		p_median[i] = gf_rows[i].similiar;
-	}
-
-	/* sort values */
-	qsort(p_median, rows_count, sizeof *p_median, compare_prec);
-
-	/* get median */
-	if ( rows_count & 1 ) {
-		result = p_median[((rows_count+1)/2)-1];
-	} else {
-		result = ((p_median[(rows_count/2)-1] + p_median[rows_count/2]) / 2);
-	}
-
-	/* free memory */
-	free(p_median);
-
-	/* check for NAN */
-	if ( result != result ) {
-		result = INVALID_VALUE;
-	}
-
-	/* */
-	return result;
-}
-
-/* private function for gapfilling */
-static int gapfill(	PREC *values,
-					const int struct_size,
-					GF_ROW *const gf_rows,
-					const int start_window,
-					const int end_window,
-					const int current_row,
-					const int start,
-					const int end,
-					const int step,
-					const int method,
-					const int timeres,
-					const PREC value1_tolerance_min,
-					const PREC value1_tolerance_max,
-					const PREC value2_tolerance_min,
-					const PREC value2_tolerance_max,
-					const PREC value3_tolerance_min,
-					const PREC value3_tolerance_max,
-					const int tofill_column,
-					const int value1_column,
-					const int value2_column,
-					const int value3_column) {
-	int i;
-	int y;
-	int j;
-	int z;
-	int window;
-	int window_start;
-	int window_end;
-	int window_current;
-	int samples_count;
-	PREC value1_tolerance;
-	PREC value2_tolerance;
-	PREC value3_tolerance;
-	PREC *window_current_values;
-	PREC *row_current_values;
-
-	/* check parameter */
-	assert(values && gf_rows && (method >=0 && method < GF_METHODS));
-	assert((timeres > SPOT_TIMERES) && (timeres <= HOURLY_TIMERES));
-
-	/* reset */
-	window = 0;
-	window_start = 0;
-	window_end = 0;
-	window_current = 0;
-	samples_count = 0;
-	value1_tolerance = value1_tolerance_min;
-	value2_tolerance = value2_tolerance_min;
-	value3_tolerance = value3_tolerance_min;
-
-	/* modified on January 17, 2018 */
-	/* j is and index checker for timeres */
-	switch ( timeres ) {
-		case QUATERHOURLY_TIMERES:
-			j = 9;
-		break;
-
-		case HALFHOURLY_TIMERES:
-			j = 5;
-		break;
-
-		case HOURLY_TIMERES:
-			j = 3;
-		break;
-	}
-
-	/* */
-	i = start;
-	if ( GF_TOFILL_METHOD == method ) {
-		/* modified on January 17, 2018 */
-		switch ( timeres ) {
-			case QUATERHOURLY_TIMERES:
-				z = 96;
-			break;
-
-			case HALFHOURLY_TIMERES:
-				z = 48;
-			break;
-
-			case HOURLY_TIMERES:
-				z = 24;
-			break;
-		}
-	} else {
-		z = 1;
-	}
-	while ( i <= end ) {
-		/* reset */
-		samples_count = 0;
-
-		/* compute window */
-		/* modified on January 17, 2018 */
-		switch ( timeres ) {
-			case QUATERHOURLY_TIMERES:
-				window = 96 * i;
-			break;
-
-			case HALFHOURLY_TIMERES:
-				window = 48 * i;
-			break;
-
-			case HOURLY_TIMERES:
-				window = 24 * i;
-			break;
-		}
-
-		/* get window start index */
-		window_start = current_row - window;
-		if ( GF_TOFILL_METHOD == method ) {
-			/* modified on January 17, 2018 */
-			switch ( timeres ) {
-				case QUATERHOURLY_TIMERES:
-					window_start -= 4;
-				break;
-
-				case HALFHOURLY_TIMERES:
-					window_start -= 2;
-				break;
-
-				case HOURLY_TIMERES:
-					window_start -= 1;
-				break;
-			}
-		}
-
-		if ( GF_TOFILL_METHOD != method ) {
-			/* fix for recreate markus code */
-			++window_start;
-		}
-
-		/* get window end index */
-		window_end = current_row + window;
-		if (GF_TOFILL_METHOD == method ) {
-			/* modified on January 17, 2018 */
-			switch ( timeres ) {
-				case QUATERHOURLY_TIMERES:
-					window_end += 5;
-				break;
-
-				case HALFHOURLY_TIMERES:
-					window_end += 3;
-				break;
-
-				case HOURLY_TIMERES:
-					window_end += 2;
-				break;
-			}
-		}
-
-		/*	fix bounds for first two methods
-			cause in hour method (NEE_METHOD) a window start at -32 and window end at 69,
-			it will be fixed to window start at 0 and this is an error...
-		*/
-		if ( GF_TOFILL_METHOD != method ) {
-			if ( window_start < 0 ) {
-				window_start = 0;
-			}
-
-			if ( window_end > end_window ) {
-				window_end = end_window;
-			}
-
-			/* modified on June 25, 2013 */
-			/* compute tolerance for value1 */
-			if ( IS_INVALID_VALUE(value1_tolerance_min) ) {
-				value1_tolerance = value1_tolerance_max;
-			} else if ( IS_INVALID_VALUE(value1_tolerance_max) ) {
-				value1_tolerance = value1_tolerance_min;
-			} else {
-				value1_tolerance = ((PREC *)(((char *)values)+current_row*struct_size))[value1_column];
-				if ( value1_tolerance < value1_tolerance_min ) {
-					value1_tolerance = value1_tolerance_min;
-				} else if ( value1_tolerance > value1_tolerance_max ) {
-					value1_tolerance = value1_tolerance_max;
-				}
-			}
-
-			/* modified on January 17, 2018 */
-			/* compute tolerance for value2 */
-			if ( IS_INVALID_VALUE(value2_tolerance_min) ) {
-				value2_tolerance = GF_DRIVER_2A_TOLERANCE_MIN;
-			} else if ( ! IS_INVALID_VALUE(value2_tolerance_max) ) {
-				value2_tolerance = ((PREC *)(((char *)values)+current_row*struct_size))[value2_column];
-				if ( value2_tolerance < value2_tolerance_min ) {
-					value2_tolerance = value2_tolerance_min;
-				} else if ( value2_tolerance > value2_tolerance_max ) {
-					value2_tolerance = value2_tolerance_max;
-				}
-			}
-
-			/* modified on January 17, 2018 */
-			/* compute tolerance for value3 */
-			if ( IS_INVALID_VALUE(value3_tolerance_min) ) {
-				value3_tolerance = GF_DRIVER_2B_TOLERANCE_MIN;
-			} else if ( ! IS_INVALID_VALUE(value3_tolerance_max) ) {
-				value3_tolerance = ((PREC *)(((char *)values)+current_row*struct_size))[value3_column];
-				if ( value3_tolerance < value3_tolerance_min ) {
-					value3_tolerance = value3_tolerance_min;
-				} else if ( value3_tolerance > value3_tolerance_max ) {
-					value3_tolerance = value3_tolerance_max;
-				}
-			}
-		}
-
-		assert(! IS_INVALID_VALUE(value1_tolerance));
-		assert(! IS_INVALID_VALUE(value2_tolerance));
-		assert(! IS_INVALID_VALUE(value3_tolerance));
-
-		/* loop through window */
-		for ( window_current = window_start; window_current < window_end; window_current += z ) {
-			window_current_values = ((PREC *)(((char *)values)+window_current*struct_size));
-			row_current_values = ((PREC *)(((char *)values)+current_row*struct_size));
-
-			switch ( method ) {
-				case GF_ALL_METHOD:
-					if ( IS_FLAG_SET(gf_rows[window_current].mask, GF_ALL_VALID) ) {
-						if (
-								(FABS(window_current_values[value2_column]-row_current_values[value2_column]) < value2_tolerance) &&
-								(FABS(window_current_values[value1_column]-row_current_values[value1_column]) < value1_tolerance) &&
-								(FABS(window_current_values[value3_column]-row_current_values[value3_column]) < value3_tolerance)
-							) {
-							gf_rows[samples_count++].similiar = window_current_values[tofill_column];
-						}
-					}
-				break;
-
-				case GF_VALUE1_METHOD:
-					if ( IS_FLAG_SET(gf_rows[window_current].mask, (GF_TOFILL_VALID|GF_VALUE1_VALID)) ) {
-						if ( FABS(window_current_values[value1_column]-row_current_values[value1_column]) < value1_tolerance ) {
-							gf_rows[samples_count++].similiar = window_current_values[tofill_column];
-						}
-					}
-				break;
-
-				case GF_TOFILL_METHOD:
-					for ( y = 0; y < j; y++ ) {
-						if ( ((window_current+y) < 0) || (window_current+y) >= end_window ) {
-							continue;
-						}
-						if ( IS_FLAG_SET(gf_rows[window_current+y].mask, GF_TOFILL_VALID) ) {
-							gf_rows[samples_count++].similiar = ((PREC *)(((char *)values)+((window_current+y)*struct_size)))[tofill_column];
-						}
-					}
-				break;
-			}
-		}
-
-		if ( samples_count > 1 ) {
-			/* set mean */
-			gf_rows[current_row].filled = gf_get_similiar_mean(gf_rows, samples_count);
-
-			/* set standard deviation */
-			gf_rows[current_row].stddev = gf_get_similiar_standard_deviation(gf_rows, samples_count);
-
-			/* set method */
-			gf_rows[current_row].method = method + 1;
-
-			/* set time-window */
-			gf_rows[current_row].time_window = i * 2;
-
-			/* fix hour method timewindow */
-			if ( GF_TOFILL_METHOD == method ) {
-				++gf_rows[current_row].time_window;
-			}
-
-			/* set samples */
-			gf_rows[current_row].samples_count = samples_count;
-
-			/* ok */
-			return 1;
-		}
-
-		/* inc loop */
-		i += step;
-
-		/* break if window bigger than  */
-		if ( (window_start < start_window) && (window_end > end_window) ) {
-			break;
-		}
-	}
-
-	/* */
-	return 0;
-}
-
-/* */
-GF_ROW *gf_mds_with_bounds(	PREC *values,
-							const int struct_size,
-							const int rows_count,
-							const int columns_count,
-							const int timeres,
-							PREC value1_tolerance_min,
-							PREC value1_tolerance_max,
-							PREC value2_tolerance_min,
-							PREC value2_tolerance_max,
-							PREC value3_tolerance_min,
-							PREC value3_tolerance_max,
-							const int tofill_column,
-							const int value1_column,
-							const int value2_column,
-							const int value3_column,
-							const int value1_qc_column,
-							const int value2_qc_column,
-							const int value3_qc_column,
-							const int qc_thrs,
-							const int values_min,
-							const int compute_hat,
-							int start_row,
-							int end_row,
-							int *no_gaps_filled_count) {
-	int i;
-	int c;
-	int valids_count;
-	GF_ROW *gf_rows;
-
-	/* */
-	assert(values && rows_count && no_gaps_filled_count);
-
-	/* reset */
-	*no_gaps_filled_count = 0;
-	if ( start_row < 0  ) {
-		start_row = 0;
-	}
-	if ( -1 == end_row ) {
-		end_row = rows_count;
-	} else if ( end_row > rows_count ) {
-		end_row = rows_count;
-	}
-
-	/* allocate memory */
-	gf_rows = malloc(rows_count*sizeof*gf_rows);
-	if ( !gf_rows ) {
-		puts(err_out_of_memory);
-		return NULL;
-	}
-
-	/* reset */
-	for ( i = 0; i < rows_count; i++ ) {
-		gf_rows[i].mask = 0;
-		gf_rows[i].similiar = INVALID_VALUE;
-		gf_rows[i].stddev = INVALID_VALUE;
-		gf_rows[i].filled = INVALID_VALUE;
-		gf_rows[i].quality = INVALID_VALUE;
-		gf_rows[i].time_window = 0;
-		gf_rows[i].samples_count = 0;
-		gf_rows[i].method = 0;
-	}
-
-	/* update mask and count valids TO FILL */
-	valids_count = 0;
-	for ( i = start_row; i < end_row; i++ ) {
-		for ( c = 0; c < columns_count; c++ ) {
-			if ( !IS_INVALID_VALUE(((PREC *)(((char *)values)+i*struct_size))[c]) ) {
-				if ( tofill_column == c ) {
-					gf_rows[i].mask |= GF_TOFILL_VALID;
-				} else if ( value1_column == c ) {
-					gf_rows[i].mask |= GF_VALUE1_VALID;
-				} else if ( value2_column == c ) {
-					gf_rows[i].mask |= GF_VALUE2_VALID;
-				} else if ( value3_column == c ) {
-					gf_rows[i].mask |= GF_VALUE3_VALID;
-				}
-			}
-		}
-
-		/* check for QC */
-		if (	!IS_INVALID_VALUE(qc_thrs) &&
-				(value1_qc_column != -1) &&
-				!IS_INVALID_VALUE(((PREC *)(((char *)values)+i*struct_size))[value1_qc_column]) ) {
-			if ( ((PREC *)(((char *)values)+i*struct_size))[value1_qc_column] > qc_thrs ) {
-				gf_rows[i].mask &= ~GF_VALUE1_VALID;
-			}
-		}
-
-		if (	!IS_INVALID_VALUE(qc_thrs) &&
-				(value2_qc_column != -1) &&
-				!IS_INVALID_VALUE(((PREC *)(((char *)values)+i*struct_size))[value2_qc_column]) ) {
-			if ( ((PREC *)(((char *)values)+i*struct_size))[value2_qc_column] > qc_thrs ) {
-				gf_rows[i].mask &= ~GF_VALUE2_VALID;
-			}
-		}
-
-		if (	!IS_INVALID_VALUE(qc_thrs) &&
-				(value3_qc_column != -1) &&
-				!IS_INVALID_VALUE(((PREC *)(((char *)values)+i*struct_size))[value3_qc_column]) ) {
-			if ( ((PREC *)(((char *)values)+i*struct_size))[value3_qc_column] > qc_thrs ) {
-				gf_rows[i].mask &= ~GF_VALUE3_VALID;
-			}
-		}
-
-		if ( IS_FLAG_SET(gf_rows[i].mask, GF_TOFILL_VALID) ) {
-			++valids_count;
-		}
-	}
-
-	if ( valids_count < values_min ) {
-		puts(err_gf_too_less_values);
-		free(gf_rows);
-		return NULL;
-	}
-
-	/* modified on January 17, 2018 */
-	if ( IS_INVALID_VALUE(value1_tolerance_min) && IS_INVALID_VALUE(value1_tolerance_max) ) {
-		value1_tolerance_min = GF_DRIVER_1_TOLERANCE_MIN;
-		value1_tolerance_max = GF_DRIVER_1_TOLERANCE_MAX;
-	} else if ( IS_INVALID_VALUE(value1_tolerance_min) ) {
-		value1_tolerance_min = GF_DRIVER_1_TOLERANCE_MIN;
-	} else if ( IS_INVALID_VALUE(value1_tolerance_max) ) {
-		value1_tolerance_max = INVALID_VALUE;
-	}
-
-	/* modified on January 17, 2018 */
-	if ( IS_INVALID_VALUE(value2_tolerance_min) && IS_INVALID_VALUE(value2_tolerance_max) ) {
-		value2_tolerance_min = GF_DRIVER_2A_TOLERANCE_MIN;
-		value2_tolerance_max = GF_DRIVER_2A_TOLERANCE_MAX;
-	} else if ( IS_INVALID_VALUE(value2_tolerance_min) ) {
-		value2_tolerance_min = GF_DRIVER_2A_TOLERANCE_MIN;
-	} else if ( IS_INVALID_VALUE(value2_tolerance_max) ) {
-		value2_tolerance_max = INVALID_VALUE;
-	}
-
-	/* modified on January 17, 2018 */
-	if ( IS_INVALID_VALUE(value3_tolerance_min) && IS_INVALID_VALUE(value3_tolerance_max) ) {
-		value3_tolerance_min = GF_DRIVER_2B_TOLERANCE_MIN;
-		value3_tolerance_max = GF_DRIVER_2B_TOLERANCE_MAX;
-	} else if ( IS_INVALID_VALUE(value3_tolerance_min) ) {
-		value3_tolerance_min = GF_DRIVER_2B_TOLERANCE_MIN;
-	} else if ( IS_INVALID_VALUE(value3_tolerance_max) ) {
-		value3_tolerance_max = INVALID_VALUE;
-	}
-
-	/* loop for each row */
-	for ( i = start_row; i < end_row; i++ ) {
-		/* copy value from TOFILL to FILLED */
-		gf_rows[i].filled = ((PREC *)(((char *)values)+i*struct_size))[tofill_column];
-
-		/* compute hat ? */
-		if ( !IS_INVALID_VALUE(gf_rows[i].filled) && !compute_hat ) {
-			continue;
-		}
-
-		/*	fill
-			Added 20140422: if a gap is impossible to fill, e.g. if with MDV there are no data in the whole dataset acquired in a range +/- one hour,
-			the data point is not filled and the qc is set to -9999
-		*/
-		if ( !gapfill(values, struct_size, gf_rows, start_row, end_row, i, 7, 14, 7, GF_ALL_METHOD, timeres, value1_tolerance_min, value1_tolerance_max, value2_tolerance_min, value2_tolerance_max, value3_tolerance_min, value3_tolerance_max, tofill_column, value1_column, value2_column, value3_column) )
-			if ( !gapfill(values, struct_size, gf_rows, start_row, end_row, i, 7, 7, 7, GF_VALUE1_METHOD, timeres, value1_tolerance_min, value1_tolerance_max, value2_tolerance_min, value2_tolerance_max, value3_tolerance_min, value3_tolerance_max, tofill_column, value1_column, value2_column, value3_column) )
-				if ( !gapfill(values, struct_size, gf_rows, start_row, end_row, i, 0, 2, 1, GF_TOFILL_METHOD, timeres, value1_tolerance_min, value1_tolerance_max, value2_tolerance_min, value2_tolerance_max, value3_tolerance_min, value3_tolerance_max, tofill_column, value1_column, value2_column, value3_column) )
-					if ( !gapfill(values, struct_size, gf_rows, start_row, end_row, i, 21, 77, 7, GF_ALL_METHOD, timeres, value1_tolerance_min, value1_tolerance_max, value2_tolerance_min, value2_tolerance_max, value3_tolerance_min, value3_tolerance_max, tofill_column, value1_column, value2_column, value3_column) )
-						if ( !gapfill(values, struct_size, gf_rows, start_row, end_row, i, 14, 77, 7, GF_VALUE1_METHOD, timeres, value1_tolerance_min, value1_tolerance_max, value2_tolerance_min, value2_tolerance_max, value3_tolerance_min, value3_tolerance_max, tofill_column, value1_column, value2_column, value3_column) )
-							if ( !gapfill(values, struct_size, gf_rows, start_row, end_row, i, 3, end_row + 1, 3, GF_TOFILL_METHOD, timeres, value1_tolerance_min, value1_tolerance_max, value2_tolerance_min, value2_tolerance_max, value3_tolerance_min, value3_tolerance_max, tofill_column, value1_column, value2_column, value3_column) ) {
-								++*no_gaps_filled_count;
-								continue;
-							}
-
-		/* compute quality */
-		gf_rows[i].quality =	(gf_rows[i].method > 0) +
-								((gf_rows[i].method == 1 && gf_rows[i].time_window > 14) || (gf_rows[i].method == 2 && gf_rows[i].time_window > 14) || (gf_rows[i].method == 3 && gf_rows[i].time_window > 1)) +
-								((gf_rows[i].method == 1 && gf_rows[i].time_window > 56) || (gf_rows[i].method == 2 && gf_rows[i].time_window > 28) || (gf_rows[i].method == 3 && gf_rows[i].time_window > 5));
-	}
-
-	/* ok */
-	return gf_rows;
-}
-
-/* */
-GF_ROW *gf_mds(PREC *values, const int struct_size, const int rows_count, const int columns_count, const int timeres,
-																									PREC value1_tolerance_min,
-																									PREC value1_tolerance_max,
-																									PREC value2_tolerance_min,
-																									PREC value2_tolerance_max,
-																									PREC value3_tolerance_min,
-																									PREC value3_tolerance_max,
-																									const int tofill_column,
-																									const int value1_column,
-																									const int value2_column,
-																									const int value3_column,
-																									const int values_min,
-																									const int compute_hat,
-																									int *no_gaps_filled_count) {
-	return gf_mds_with_bounds(	values,
-								struct_size,
-								rows_count,
-								columns_count,
-								timeres,
-								value1_tolerance_min,
-								value1_tolerance_max,
-								value2_tolerance_min,
-								value2_tolerance_max,
-								value3_tolerance_min,
-								value3_tolerance_max,
-								tofill_column,
-								value1_column,
-								value2_column,
-								value3_column,
-								-1,
-								-1,
-								-1,
-								INVALID_VALUE,
-								values_min,
-								compute_hat,
-								-1,
-								-1,
-								no_gaps_filled_count
-	);
-}
-
-/* */
-GF_ROW *gf_mds_with_qc(PREC *values, const int struct_size, const int rows_count, const int columns_count, const int timeres,
-																										PREC value1_tolerance_min,
-																										PREC value1_tolerance_max,
-																										PREC value2_tolerance_min,
-																										PREC value2_tolerance_max,
-																										PREC value3_tolerance_min,
-																										PREC value3_tolerance_max,
-																										const int tofill_column,
-																										const int value1_column,
-																										const int value2_column,
-																										const int value3_column,
-																										const int value1_qc_column,
-																										const int value2_qc_column,
-																										const int value3_qc_column,
-																										const int qc_thrs,
-																										const int values_min,
-																										const int compute_hat,
-																										int *no_gaps_filled_count) {
-	return gf_mds_with_bounds(	values,
-								struct_size,
-								rows_count,
-								columns_count,
-								timeres,
-								value1_tolerance_min,
-								value1_tolerance_max,
-								value2_tolerance_min,
-								value2_tolerance_max,
-								value3_tolerance_min,
-								value3_tolerance_max,
-								tofill_column,
-								value1_column,
-								value2_column,
-								value3_column,
-								value1_qc_column,
-								value2_qc_column,
-								value3_qc_column,
-								qc_thrs,
-								values_min,
-								compute_hat,
-								-1,
-								-1,
-								no_gaps_filled_count
-	);
+	return timestamp_ww_get_by_row_s_r(row, yy, timeres, start, buffer);
 }
 
 /* */
@@ -2274,6 +1530,250 @@ int timestamp_difference_in_seconds(const TIMESTAMP* const p1, const TIMESTAMP*
 	return s1-s2;
 }
 
+/* added on October 18, 2026 */
+static int days_from_civil(int y, const int m, const int d) {
+	int era;
+	int yoe;
+	int doy;
+	int doe;
+
+	y -= m <= 2;
+	era = (y >= 0 ? y : y-399) / 400;
+	yoe = y - era * 400;
+	doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+	doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+	return era * 146097 + doe - 719468;
+}
+
+/* added on October 18, 2026 */
+int timestamp_to_epoch_minutes(const TIMESTAMP* const p) {
+	assert(p);
+
+	return days_from_civil(p->YYYY, p->MM, p->DD) * 1440 + p->hh * 60 + p->mm;
+}
+
+/* added on October 18, 2026 */
+void timestamp_from_epoch_minutes(int minutes, TIMESTAMP* const p) {
+	int days;
+	int era;
+	int doe;
+	int yoe;
+	int doy;
+	int mp;
+
+	assert(p);
+
+	/* floor division */
+	days = minutes / 1440;
+	minutes %= 1440;
+	if ( minutes < 0 ) {
+		minutes += 1440;
+		--days;
+	}
+
+	days += 719468;
+	era = (days >= 0 ? days : days - 146096) / 146097;
+	doe = days - era * 146097;
+	yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	mp = (5 * doy + 2) / 153;
+
+	p->DD = doy - (153 * mp + 2) / 5 + 1;
+	p->MM = mp < 10 ? mp + 3 : mp - 9;
+	p->YYYY = yoe + era * 400 + (p->MM <= 2);
+	p->hh = minutes / 60;
+	p->mm = minutes % 60;
+	p->ss = 0;
+}
+
+/*
+	added on October 18, 2026
+
+	moves p forward by minutes (>= 0) carrying on hours, days, months and years,
+	so successive timestamps can be produced without a full civil conversion
+*/
+void timestamp_add_minutes(TIMESTAMP* const p, int minutes) {
+	int days;
+	int days_in_month;
+	static const int days_per_month[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+	assert(p && (minutes >= 0));
+
+	minutes += p->mm;
+	p->mm = minutes % 60;
+	minutes = p->hh + minutes / 60;
+	p->hh = minutes % 24;
+	for ( days = minutes / 24; days > 0; days-- ) {
+		days_in_month = days_per_month[p->MM-1];
+		if ( (2 == p->MM) && IS_LEAP_YEAR(p->YYYY) ) {
+			++days_in_month;
+		}
+		if ( ++p->DD > days_in_month ) {
+			p->DD = 1;
+			if ( ++p->MM > 12 ) {
+				p->MM = 1;
+				++p->YYYY;
+			}
+		}
+	}
+}
+
+/* added on October 18, 2026 */
+int get_minutes_per_row_by_timeres(const int timeres) {
+	assert((timeres > SPOT_TIMERES) && (timeres <= HOURLY_TIMERES));
+
+	return 1440 / get_rows_per_day_by_timeres(timeres);
+}
+
+/*
+	added on October 18, 2026
+
+	returns -1 if timestamp is before calendar start
+	or not aligned to calendar step
+*/
+int calendar_get_row(const CALENDAR *const calendar, const TIMESTAMP *const t) {
+	int minutes;
+
+	assert(calendar && t && calendar->step);
+
+	minutes = timestamp_to_epoch_minutes(t) - calendar->start;
+	if ( (minutes < 0) || (minutes % calendar->step) ) {
+		return -1;
+	}
+
+	return minutes / calendar->step;
+}
+
+/*
+	added on October 18, 2026
+
+	row is 0 based and counted from the start of year yy,
+	the end of a row is the start of the next one
+*/
+TIMESTAMP *timestamp_get_by_row_r(int row, int yy, const int timeres, const int start, TIMESTAMP *const t) {
+	assert((timeres > SPOT_TIMERES) && (timeres <= HOURLY_TIMERES));
+	assert(t);
+
+	if ( ! start ) {
+		++row;
+	}
+	timestamp_from_epoch_minutes(days_from_civil(yy, 1, 1) * 1440 + row * get_minutes_per_row_by_timeres(timeres), t);
+
+	return t;
+}
+
+/* added on October 18, 2026 */
+char *timestamp_get_by_row_s_r(int row, int yy, const int timeres, const int start, char *const buffer) {
+	TIMESTAMP t;
+
+	assert(buffer);
+
+	timestamp_get_by_row_r(row, yy, timeres, start, &t);
+	sprintf(buffer, "%04d%02d%02d%02d%02d", t.YYYY, t.MM, t.DD, t.hh, t.mm);
+
+	return buffer;
+}
+
+/* added on October 18, 2026 */
+TIMESTAMP *timestamp_ww_get_by_row_r(int row, int year, const int timeres, int start, TIMESTAMP *const t) {
+	int i;
+	int last;
+
+	/* */
+	assert((row >= 0) &&(row < 52));
+	assert((timeres > SPOT_TIMERES) && (timeres <= HOURLY_TIMERES));
+
+	/* */
+	last = (52-1 == row);
+	i = 7 * get_rows_per_day_by_timeres(timeres);
+	row *= i;
+
+	/* */
+	if ( ! start ) {
+		if ( last ) {
+			row = get_rows_count_by_timeres(timeres, year);
+		} else {
+			row += i;
+		}
+		start = 1;
+		--row;
+	}
+
+	/* */
+	return timestamp_get_by_row_r(row, year, timeres, start, t);
+}
+
+/* added on October 18, 2026 */
+char *timestamp_ww_get_by_row_s_r(int row, int yy, const int timeres, const int start, char *const buffer) {
+	TIMESTAMP t;
+
+	assert(buffer);
+
+	timestamp_ww_get_by_row_r(row, yy, timeres, start, &t);
+	sprintf(buffer, "%04d%02d%02d", t.YYYY, t.MM, t.DD);
+
+	return buffer;
+}
+
+/* added on October 18, 2026 */
+TIMESTAMP *calendar_get_by_row_r(const CALENDAR *const calendar, const int row, const int start, TIMESTAMP *const t) {
+	assert(calendar && t);
+
+	timestamp_from_epoch_minutes(calendar->start + (row - (start ? 1 : 0)) * calendar->step, t);
+
+	return t;
+}
+
+/* added on October 18, 2026 */
+char *calendar_get_by_row_s_r(const CALENDAR *const calendar, const int row, const int start, char *const buffer) {
+	TIMESTAMP t;
+
+	assert(calendar && buffer);
+
+	calendar_get_by_row_r(calendar, row, start, &t);
+	sprintf(buffer, "%04d%02d%02d%02d%02d", t.YYYY, t.MM, t.DD, t.hh, t.mm);
+
+	return buffer;
+}
+
+/* updated on October 18, 2026: wrapper of calendar_get_by_row_r */
+TIMESTAMP *calendar_get_by_row(const CALENDAR *const calendar, const int row, const int start) {
+	static TIMESTAMP t = { 0 };
+
+	return calendar_get_by_row_r(calendar, row, start, &t);
+}
+
+/* updated on October 18, 2026: wrapper of calendar_get_by_row_s_r */
+char *calendar_get_by_row_s(const CALENDAR *const calendar, const int row, const int start) {
+	static char buffer[TIMESTAMP_STRING_SIZE] = { 0 };
+
+	return calendar_get_by_row_s_r(calendar, row, start, buffer);
+}
+
+/*
+	added on October 18, 2026
+
+	forward iterator over the timestamps of a calendar, O(1) per row
+*/
+void timestamp_iterator_init(TIMESTAMP_ITERATOR *const iterator, const CALENDAR *const calendar, const int row, const int start) {
+	assert(iterator && calendar);
+
+	iterator->step = calendar->step;
+	iterator->row = row;
+	calendar_get_by_row_r(calendar, row, start, &iterator->t);
+}
+
+/* added on October 18, 2026 */
+const TIMESTAMP *timestamp_iterator_next(TIMESTAMP_ITERATOR *const iterator) {
+	assert(iterator);
+
+	++iterator->row;
+	timestamp_add_minutes(&iterator->t, iterator->step);
+
+	return &iterator->t;
+}
+
 #if defined (_WIN32) && defined (_DEBUG) 
 void dump_memory_leaks(void) {
 	_CrtDumpMemoryLeaks();
@@ -33,6 +33,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 /* includes */
 #include <math.h>
+#include "gfmds.h"
 
 #ifndef isnan
 	# define isnan(x) \
@@ -90,10 +91,10 @@ enum {
 
 /* gf */
 enum {
-	GF_TOFILL_VALID		= 1 << 0 ,
-	GF_VALUE1_VALID		= 1 << 1 ,
-	GF_VALUE2_VALID		= 1 << 2 ,
-	GF_VALUE3_VALID		= 1 << 3 ,
+	GF_TOFILL_VALID		= GFMDS_TOFILL_VALID ,
+	GF_VALUE1_VALID		= GFMDS_DRIVER1_VALID ,
+	GF_VALUE2_VALID		= GFMDS_DRIVER2A_VALID ,
+	GF_VALUE3_VALID		= GFMDS_DRIVER2B_VALID ,
 	GF_ALL_VALID		= GF_TOFILL_VALID|GF_VALUE1_VALID|GF_VALUE2_VALID|GF_VALUE3_VALID
 };
 
@@ -162,17 +163,37 @@ typedef struct {
 	int ss;
 } TIMESTAMP;
 
-/* structure for gapfilling */
+/* added on October 18, 2026 */
+#define TIMESTAMP_STRING_SIZE		(12+1)	/* YYYYMMDDhhmm */
+#define TIMESTAMP_WW_STRING_SIZE	(8+1)	/* YYYYMMDD */
+
+/*
+	added on October 18, 2026
+
+	t is the timestamp of row, use timestamp_iterator_next to move
+	to the following one
+*/
 typedef struct {
-	char mask;
-	PREC similiar;
-	PREC stddev;
-	PREC filled;
-	int quality;
-	int time_window;
-	int samples_count;
-	int method;
-} GF_ROW;
+	TIMESTAMP t;
+	int step;
+	int row;
+} TIMESTAMP_ITERATOR;
+
+/*
+	calendar index, added on October 18, 2026
+
+	rows are addressed by their TIMESTAMP_END expressed in minutes
+	elapsed since 1970-01-01 00:00, so a dataset can start and end
+	at any timestamp, not only at year boundaries
+*/
+typedef struct {
+	int start;			/* TIMESTAMP_END of first row in minutes since epoch */
+	int step;			/* minutes between rows */
+	int rows_count;
+} CALENDAR;
+
+/* structure for gapfilling, updated on October 18, 2026: see gfmds.h */
+typedef GFMDS_ROW GF_ROW;
 
 /* extern */
 extern const char err_out_of_memory[];
@@ -199,6 +220,7 @@ char *get_current_directory(void);
 int add_char_to_string(char *const string, char c, const int size);
 int file_exists(const char *const file);
 int path_exists(const char *const path);
+long long get_file_size(const char *const filename);
 int compare_prec(const void * a, const void * b);
 char *tokenizer(char *string, char *delimiter, char **p);
 int create_dir(char *Path);
@@ -221,78 +243,15 @@ TIMESTAMP *timestamp_ww_get_by_row(int row, int yy, const int hourly_dataset, in
 #define timestamp_end_ww_by_row_s(r,y,h) timestamp_get_by_row_s((r),(y),(h),0)
 char *timestamp_ww_get_by_row_s(int row, int yy, const int hourly_dataset, const int start);
 
-/* gf */
-GF_ROW *gf_mds(		PREC *values,
-					const int struct_size,
-					const int rows_count,
-					const int columns_count,
-					const int hourly_dataset,
-					PREC value1_tolerance_min,
-					PREC value1_tolerance_max,
-					PREC value2_tolerance_min,
-					PREC value2_tolerance_max,
-					PREC value3_tolerance_min,
-					PREC value3_tolerance_max,
-					const int tofill_column,
-					const int value1_column,
-					const int value2_column,
-					const int value3_column,
-					const int values_min,
-					const int compute_hat,
-					int *no_gaps_filled_count
-);
-
-GF_ROW *gf_mds_with_qc(	PREC *values,
-						const int struct_size,
-						const int rows_count,
-						const int columns_count,
-						const int hourly_dataset,
-						PREC value1_tolerance_min,
-						PREC value1_tolerance_max,
-						PREC value2_tolerance_min,
-						PREC value2_tolerance_max,
-						PREC value3_tolerance_min,
-						PREC value3_tolerance_max,
-						const int tofill_column,
-						const int value1_column,
-						const int value2_column,
-						const int value3_column,
-						const int value1_qc_column,
-						const int value2_qc_column,
-						const int value3_qc_column,
-						const int qc_thrs,
-						const int values_min,
-						const int compute_hat,
-						int *no_gaps_filled_count
-);
-
-GF_ROW *gf_mds_with_bounds(	PREC *values,
-							const int struct_size,
-							const int rows_count,
-							const int columns_count,
-							const int hourly_dataset,
-							PREC value1_tolerance_min,
-							PREC value1_tolerance_max,
-							PREC value2_tolerance_min,
-							PREC value2_tolerance_max,
-							PREC value3_tolerance_min,
-							PREC value3_tolerance_max,
-							const int tofill_column,
-							const int value1_column,
-							const int value2_column,
-							const int value3_column,
-							const int value1_qc_column,
-							const int value2_qc_column,
-							const int value3_qc_column,
-							const int qc_thrs,
-							const int values_min,
-							const int compute_hat,
-							int start_row,
-							int end_row,
-							int *no_gaps_filled_count
-);
-PREC gf_get_similiar_standard_deviation(const GF_ROW *const gf_rows, const int rows_count);
-PREC gf_get_similiar_median(const GF_ROW *const gf_rows, const int rows_count, int *const error);
+/* reentrant versions, added on October 18, 2026 */
+#define timestamp_start_by_row_r(r,y,h,t) timestamp_get_by_row_r((r),(y),(h),1,(t))
+#define timestamp_end_by_row_r(r,y,h,t) timestamp_get_by_row_r((r),(y),(h),0,(t))
+TIMESTAMP *timestamp_get_by_row_r(int row, int yy, const int timeres, const int start, TIMESTAMP *const t);
+#define timestamp_start_by_row_s_r(r,y,h,b) timestamp_get_by_row_s_r((r),(y),(h),1,(b))
+#define timestamp_end_by_row_s_r(r,y,h,b) timestamp_get_by_row_s_r((r),(y),(h),0,(b))
+char *timestamp_get_by_row_s_r(int row, int yy, const int timeres, const int start, char *const buffer);
+TIMESTAMP *timestamp_ww_get_by_row_r(int row, int yy, const int timeres, int start, TIMESTAMP *const t);
+char *timestamp_ww_get_by_row_s_r(int row, int yy, const int timeres, const int start, char *const buffer);
 
 /*  */
 int get_rows_count_by_timeres(const int timeres, const int year);
@@ -306,6 +265,26 @@ void check_memory_leak(void);
 
 int check_timestamp(const TIMESTAMP* const p);
 int timestamp_difference_in_seconds(const TIMESTAMP* const p1, const TIMESTAMP* const p2);
+int timestamp_to_epoch_minutes(const TIMESTAMP* const p);
+void timestamp_from_epoch_minutes(int minutes, TIMESTAMP* const p);
+void timestamp_add_minutes(TIMESTAMP* const p, int minutes);
+
+int get_minutes_per_row_by_timeres(const int timeres);
+int calendar_get_row(const CALENDAR *const calendar, const TIMESTAMP *const t);
+#define calendar_start_by_row(c,r) calendar_get_by_row((c),(r),1)
+#define calendar_end_by_row(c,r) calendar_get_by_row((c),(r),0)
+TIMESTAMP *calendar_get_by_row(const CALENDAR *const calendar, const int row, const int start);
+#define calendar_start_by_row_s(c,r) calendar_get_by_row_s((c),(r),1)
+#define calendar_end_by_row_s(c,r) calendar_get_by_row_s((c),(r),0)
+char *calendar_get_by_row_s(const CALENDAR *const calendar, const int row, const int start);
+#define calendar_start_by_row_r(c,r,t) calendar_get_by_row_r((c),(r),1,(t))
+#define calendar_end_by_row_r(c,r,t) calendar_get_by_row_r((c),(r),0,(t))
+TIMESTAMP *calendar_get_by_row_r(const CALENDAR *const calendar, const int row, const int start, TIMESTAMP *const t);
+#define calendar_start_by_row_s_r(c,r,b) calendar_get_by_row_s_r((c),(r),1,(b))
+#define calendar_end_by_row_s_r(c,r,b) calendar_get_by_row_s_r((c),(r),0,(b))
+char *calendar_get_by_row_s_r(const CALENDAR *const calendar, const int row, const int start, char *const buffer);
+void timestamp_iterator_init(TIMESTAMP_ITERATOR *const iterator, const CALENDAR *const calendar, const int row, const int start);
+const TIMESTAMP *timestamp_iterator_next(TIMESTAMP_ITERATOR *const iterator);
 
 #if defined (_WIN32) && defined (_DEBUG) 
 void dump_memory_leaks(void);
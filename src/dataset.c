@@ -29,170 +29,223 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include <string.h>
 #include <assert.h>
 #include "dataset.h"
+#include "reader.h"
 
-/* structures */
-typedef struct {
-	ROW *rows;
-	int *columns;
-	TIMESTAMP *timestamps;
-	int rows_count;
-	int allocated_rows_count;
-} DATASET;
+/*
+	constants
+
+	rows later than this past the first timestamp are rejected,
+	a mistyped year would otherwise allocate the whole gap
+*/
+#define DATASET_YEARS_MAX	50
 
 /* extern variables */
-extern int *years;
-extern int years_count;
 extern int timeres;
+extern int full_years;
 extern int custom_tokens[GF_TOKENS];
 extern const char def_tokens[GF_TOKENS][GF_TOKEN_LENGTH_MAX+1];
 extern char tokens[GF_TOKENS][GF_TOKEN_LENGTH_MAX+1];
 
 /* strings */
 static const char delimiter[] = ", ";
+#ifdef _DEBUG
+static const char debug_file[] = "dataset_debug_clean.csv";
+#endif
 
 /* error strings */
 static const char err_redundancy[] = "redundancy: var \"%s\" already founded at column %d.\n";
 static const char err_unable_find_column[] = "unable to find column for \"%s\" var.\n";
+static const char err_field_too_long[] = "field %d at row %d is too long.\n";
 static const char err_conversion[] = "error during conversion of \"%s\" value at row %d, column %d.\n";
 static const char err_timestamp_conversion[] = "error during conversion of %s at row %d.\n";
 static const char err_row_assigned[] = "row %d already assigned!\n";
-static const char err_invalid_index[]= "invalid %s at row %d\n";
-static const char err_unable_get_header[] = "unable to get header.";
 static const char err_unable_to_import_all_values[] = "unable to import all values for row %d\n";
-static const char err_no_timestamp[]= "unable to concatenate dataset with %s. please use %s instead.\n";
 static const char err_invalid_timestamp[] = "invalid timestamp at row %d: %04d%02d%02d%02d%02d%02d\n";
 static const char err_invalid_freq[] = "invalid timestamp at row %d\n";
 static const char err_unable_to_create_debug_file[] = "unable to create import debug file: %s\n";
-static const char err_too_many_rows[] = "too many rows found! %d instead of %d\n";
+static const char err_unable_read_file[] = "unable to read %s: file is truncated or corrupted.\n";
+static const char err_not_chronological[] = "timestamp at row %d precedes dataset start. files must be in chronological order.\n";
+static const char err_span_too_long[] = "timestamp at row %d is more than %d years after dataset start.\n";
 
 /* extern error strings */
 extern const char err_empty_file[];
 extern const char err_out_of_memory[];
 extern const char err_unable_open_file[];
 
-/* */
-static void free_datasets(DATASET *datasets, const int count) {
+/* added on October 18, 2026 */
+static void reset_rows(ROW *const rows, const int start, const int count) {
 	int i;
+	int y;
 
-	for ( i = 0; i < count; i++ ) {	
-		free(datasets[i].timestamps);
-		free(datasets[i].rows);
-		free(datasets[i].columns);
+	for ( i = 0; i < count; i++ ) {
+		for ( y = 0; y < GF_REQUIRED_DATASET_VALUES; y++ ) {
+			if ( GF_ROW_INDEX == y ) {
+				rows[start+i].value[y] = start+i;
+			} else {
+				rows[start+i].value[y] = INVALID_VALUE;
+			}
+		}
+		rows[start+i].assigned = 0;
 	}
-	free(datasets);
 }
 
-/* updated on January 17, 2018 */
-ROW *import_dataset(const LIST *const list, const int list_count, int *const rows_count) {
+/* added on October 18, 2026 */
+static int check_timeres(const int freq) {
+	switch ( timeres ) {
+		case QUATERHOURLY_TIMERES:
+			return 15 == freq;
+
+		case HALFHOURLY_TIMERES:
+			return 30 == freq;
+
+		case HOURLY_TIMERES:
+			return 60 == freq;
+	}
+
+	return 1;
+}
+
+/* added on October 18, 2026 */
+static ROW *grow_rows(ROW *rows, int *const allocated_rows_count, const int rows_count) {
+	int i;
+	ROW *rows_no_leak;
+
+	/* grow by one year of rows at least */
+	i = *allocated_rows_count + get_rows_count_by_timeres(timeres, 2000);
+	if ( i < rows_count ) {
+		i = rows_count;
+	}
+
+	rows_no_leak = realloc(rows, i*sizeof*rows_no_leak);
+	if ( !rows_no_leak ) {
+		puts(err_out_of_memory);
+		free(rows);
+		return NULL;
+	}
+	reset_rows(rows_no_leak, *allocated_rows_count, i-*allocated_rows_count);
+	*allocated_rows_count = i;
+
+	return rows_no_leak;
+}
+
+/* added on October 18, 2026 */
+static int get_year_begin_in_minutes(const int minutes, const int step, const int years_to_add) {
+	TIMESTAMP t;
+
+	/* year of a row is the one of its TIMESTAMP_START */
+	timestamp_from_epoch_minutes(minutes - step, &t);
+	t.YYYY += years_to_add;
+	t.MM = 1;
+	t.DD = 1;
+	t.hh = 0;
+	t.mm = 0;
+
+	return timestamp_to_epoch_minutes(&t);
+}
+
+/*
+	updated on October 18, 2026
+
+	rows are parsed and placed directly in their final slot, indexed by
+	minutes elapsed from the first timestamp, so only the covered span is
+	allocated. (use full_years to pad the dataset to whole calendar years)
+	timestamps are validated as a stream keeping only the previous one.
+	tofill (GF_TOKEN_LENGTH_MAX+1 chars) receives the name of the var to
+	fill as written in the input header.
+	prefetch (can be NULL) may already hold files in memory.
+*/
+ROW *import_dataset(const LIST *const list, const int list_count, CALENDAR *const calendar, char *const tofill, PREFETCH *const prefetch) {
 	int i;
 	int y;
-	int j;
-	int z;
 	int file;
 	int assigned_required_values_count;
 	int error;
-	int old_year;
-	char *p;
-	char *token;
-	FILE *f;
+	int allocated_rows_count;
+	int file_rows_count;
+	int freq;
+	int freq_row;
+	int last_column;
+	int length;
+	int buffer_size;
+	int columns[GF_REQUIRED_DATASET_VALUES];
+	READER *reader;
 	PREC value;
+	PREC values[GF_REQUIRED_DATASET_VALUES];
 	ROW *rows;
 	ROW *rows_no_leak;
-	DATASET *datasets;
-	char buffer[BUFFER_SIZE];
+	TIMESTAMP *t;
+	TIMESTAMP current;
+	TIMESTAMP previous;
+	char token[READER_FIELD_SIZE];
+	char *buffer;
 
 	/* check parameters */
-	assert(list && rows_count);
-
-	*rows_count = 0;
-
-	/* alloc memory for datasets */
-	datasets = malloc(list_count*sizeof*datasets);
-	if ( !datasets ) {
-		puts(err_out_of_memory);
-		return NULL;
-	}
-	memset(datasets, 0, list_count*sizeof*datasets);
-
-	/* alloc memory for rows and columns in datasets */
-	for ( i = 0; i < list_count; i++ ) {
-		datasets[i].allocated_rows_count = LEAP_YEAR_ROWS;
-		datasets[i].rows = malloc(datasets[i].allocated_rows_count*sizeof*datasets[i].rows);
-		if ( !datasets[i].rows ) {
-			puts(err_out_of_memory);
-			free_datasets(datasets, list_count);
-			return NULL;
-		}
+	assert(list && calendar && tofill);
 
-		datasets[i].columns = malloc(GF_REQUIRED_DATASET_VALUES*sizeof*datasets[i].columns);
-		if ( !datasets[i].columns ) {
-			puts(err_out_of_memory);
-			free_datasets(datasets, list_count);
-			return NULL;
-		}
-
-		datasets[i].timestamps = malloc(datasets[i].allocated_rows_count*sizeof*datasets[i].timestamps);
-		if ( !datasets[i].timestamps ) {
-			puts(err_out_of_memory);
-			free_datasets(datasets, list_count);
-			return NULL;
-		}
-		memset(datasets[i].timestamps, 0, datasets[i].allocated_rows_count*sizeof*datasets[i].timestamps);
-	}
-
-	/* alloc memory for years */
-	years = malloc(list_count*sizeof*years);
-	if ( !years ) {
-		puts(err_out_of_memory);
-		free_datasets(datasets, list_count);
-		return NULL;
-	}
+	/* reset */
+	calendar->start = 0;
+	calendar->step = get_minutes_per_row_by_timeres(timeres);
+	calendar->rows_count = 0;
+	allocated_rows_count = 0;
+	rows = NULL;
 
 	/* loop for each file */
-	//*rows_count = 0; /* we must reset here 'cause we can have concatenated datasets */
 	for ( file = 0; file < list_count; file++ ) {
-		/* reset datasets */
-		datasets[file].rows_count = 0;
-
-		/* open file */
-		f = fopen(list[file].fullpath, "r");
-		if ( !f ) {
+		/* open file, from memory if already read by prefetch */
+		if ( prefetch && prefetch_take(prefetch, list[file].fullpath, &buffer, &buffer_size) ) {
+			reader = reader_open_buffer(buffer, buffer_size, delimiter);
+			if ( !reader ) {
+				free(buffer);
+			}
+		} else {
+			reader = reader_open(list[file].fullpath, delimiter);
+		}
+		if ( !reader ) {
 			puts(err_unable_open_file);
-			free_datasets(datasets, list_count);
-			return 0;
+			free(rows);
+			return NULL;
 		}
 
 		/* */
-		if ( !get_valid_line_from_file(f, buffer, BUFFER_SIZE) ) {
-			puts(err_empty_file);
-			fclose(f);
-			free_datasets(datasets, list_count);
-			return 0;
+		if ( !reader_next_line(reader) ) {
+			if ( reader_has_error(reader) ) {
+				printf(err_unable_read_file, list[file].name);
+			} else {
+				puts(err_empty_file);
+			}
+			reader_close(reader);
+			free(rows);
+			return NULL;
 		}
 
 		/* reset column positions */
 		for ( i = 0; i < GF_REQUIRED_DATASET_VALUES; i++ ) {
-			datasets[file].columns[i] = -1;
-		}	
+			columns[i] = -1;
+		}
 
 		/* parse header */
-		for ( i = 0, token = string_tokenizer(buffer, delimiter, &p); token; token = string_tokenizer(NULL, delimiter, &p), ++i ) {
+		for ( i = 0; -1 != (length = reader_get_field(reader, token, GF_TOKEN_LENGTH_MAX+1)); ++i ) {
+			/* longer names can't match any var */
+			if ( length > GF_TOKEN_LENGTH_MAX ) {
+				continue;
+			}
 			for ( y = 0; y < GF_REQUIRED_DATASET_VALUES; y++ ) {
 				if ( ! string_compare_i(token, tokens[y]) ) {
 					/* check if column was already assigned */
-					if ( -1 != datasets[file].columns[y] ) {
-						printf(err_redundancy, tokens[y], datasets[file].columns[y]+1);
-						free_datasets(datasets, list_count);
-						fclose(f);
+					if ( -1 != columns[y] ) {
+						printf(err_redundancy, tokens[y], columns[y]+1);
+						reader_close(reader);
+						free(rows);
 						return NULL;
 					} else {
 						/* assign column position */
-						datasets[file].columns[y] = i;
+						columns[y] = i;
 
 						/* use same case as input for tofill var */
+						/* updated on October 18, 2026: tokens are shared by concurrent jobs, name is returned in tofill */
 						if ( GF_TOFILL == y )
 						{
-							strcpy(tokens[y], token);
+							strcpy(tofill, token);
 						}
 
 						/* do not break loop for var 'cause we can use var to be filled in methods! */
@@ -202,114 +255,124 @@ ROW *import_dataset(const LIST *const list, const int list_count, int *const row
 			}
 		}
 
+		/* updated on October 18, 2026 */
+		if ( reader_has_error(reader) ) {
+			printf(err_unable_read_file, list[file].name);
+			reader_close(reader);
+			free(rows);
+			return NULL;
+		}
+
 		/* check for required colums */
+		last_column = 0;
 		for ( i = 0; i < GF_REQUIRED_DATASET_VALUES; i++ ) {
-			if ( -1 == datasets[file].columns[i] ) {
+			if ( -1 == columns[i] ) {
 				printf(err_unable_find_column, tokens[i]);
-				free_datasets(datasets, list_count);
-				fclose(f);
+				reader_close(reader);
+				free(rows);
 				return NULL;
 			}
+			if ( columns[i] > last_column ) {
+				last_column = columns[i];
+			}
 		}
 
 		/* import values */
-		while ( get_valid_line_from_file(f, buffer, BUFFER_SIZE) ) {
-			/* alloc rows if needed */
-			if ( datasets[file].rows_count++ == datasets[file].allocated_rows_count ) {
-				/* we allocate leap rows to prevent out of bounds! */
-				i = get_rows_count_by_timeres(timeres, 2000);
-				
-				datasets[file].allocated_rows_count += i;
-				rows_no_leak = realloc(datasets[file].rows, datasets[file].allocated_rows_count*sizeof*rows_no_leak);
-				if ( !rows_no_leak ) {
-					puts(err_out_of_memory);
-					free_datasets(datasets, list_count);
-					fclose(f);
-					return NULL;
-				}
+		file_rows_count = 0;
+		freq = 0;
+		freq_row = 0;
+		while ( reader_next_line(reader) ) {
+			++file_rows_count;
 
-				/* assign pointer */
-				datasets[file].rows = rows_no_leak;
-
-				/* re-alloc memory for timestamps */
-				{
-					int z;
-					TIMESTAMP* timestamp_no_leak;
-
-					timestamp_no_leak = realloc(datasets[file].timestamps, datasets[file].allocated_rows_count*sizeof*timestamp_no_leak);
-					if ( !timestamp_no_leak ) {
-						puts(err_out_of_memory);
-						free_datasets(datasets, list_count);
-						fclose(f);
-						return NULL;
-					}
-
-					/* assign pointer */
-					datasets[file].timestamps = timestamp_no_leak;
-
-					for ( z = i; z < datasets[file].allocated_rows_count; ++z ) {
-						memset(&datasets[file].timestamps[z], 0, sizeof(TIMESTAMP));
+			/* get values, columns after last required one are not scanned at all */
+			assigned_required_values_count = 0;
+			for ( i = 0; i <= last_column; i++ ) {
+				/* copy only required columns */
+				for ( y = 0; y < GF_REQUIRED_DATASET_VALUES; y++ ) {
+					if ( columns[y] == i ) {
+						break;
 					}
 				}
-			}
+				length = reader_get_field(reader, (y < GF_REQUIRED_DATASET_VALUES) ? token : NULL, READER_FIELD_SIZE);
+				if ( -1 == length ) {
+					break;
+				}
+				if ( length >= READER_FIELD_SIZE ) {
+					printf(err_field_too_long, i+1, file_rows_count);
+					reader_close(reader);
+					free(rows);
+					return NULL;
+				}
 
-			/* get values */
-			assigned_required_values_count = 0;
-			for ( i = 0, token = string_tokenizer(buffer, delimiter, &p); token; token = string_tokenizer(NULL, delimiter, &p), i++ ) {
 				/* loop for each mandatory values */
-				for ( y = 0; y < GF_REQUIRED_DATASET_VALUES; y++ ) {
-					if ( datasets[file].columns[y] == i ) {
+				for ( ; y < GF_REQUIRED_DATASET_VALUES; y++ ) {
+					if ( columns[y] == i ) {
 						if ( GF_ROW_INDEX == y ) {
-							TIMESTAMP* t;
-
 							t = get_timestamp(token);
 							if ( ! t ) {
-								printf(err_conversion, token, i+1, datasets[file].rows_count);
-								free_datasets(datasets, list_count);
-								fclose(f);
+								printf(err_conversion, token, i+1, file_rows_count);
+								reader_close(reader);
+								free(rows);
+								return NULL;
+							}
+							current = *t;
+							free(t);
+
+							/* validate timestamp */
+							if ( ! check_timestamp(&current) ) {
+								printf(err_invalid_timestamp, file_rows_count
+											, current.YYYY
+											, current.MM
+											, current.DD
+											, current.hh
+											, current.mm
+											, current.ss
+								);
+								reader_close(reader);
+								free(rows);
 								return NULL;
 							}
-							datasets[file].timestamps[datasets[file].rows_count-1] = *t;
-
-							/* set year */
-							if ( !(datasets[file].rows_count-1) ) {
-								years[file] = t->YYYY;
-								old_year = years[file];
-								*rows_count += get_rows_count_by_timeres(timeres, t->YYYY);
-							} else {
-								/*
-									check if year is changed...
-									we don't know if is a multi-year dataset...
-
-								*/
-								if ( old_year != t->YYYY ) {
-									/* check if is last year */
-									if ( (t->MM != 1)
-										|| (t->DD != 1)
-										|| (t->hh != 0)
-										|| (t->mm != 0) ) {
-											*rows_count += get_rows_count_by_timeres(timeres, t->YYYY);
-											old_year = t->YYYY;
-									}
+
+							/* first row of dataset sets calendar start */
+							if ( !allocated_rows_count ) {
+								calendar->start = timestamp_to_epoch_minutes(&current);
+								if ( full_years ) {
+									calendar->start = get_year_begin_in_minutes(calendar->start, calendar->step, 0) + calendar->step;
+								}
+								rows = grow_rows(rows, &allocated_rows_count, 1);
+								if ( !rows ) {
+									reader_close(reader);
+									return NULL;
 								}
+							}
 
+							if ( timestamp_to_epoch_minutes(&current) < calendar->start ) {
+								printf(err_not_chronological, file_rows_count);
+								reader_close(reader);
+								free(rows);
+								return NULL;
 							}
-							j = get_row_by_timestamp(t, timeres);
-							free(t);
-							if ( -1 == j ) {
-								printf(err_timestamp_conversion, tokens[GF_ROW_INDEX], datasets[file].rows_count);
-								free_datasets(datasets, list_count);
-								fclose(f);
+
+							value = calendar_get_row(calendar, &current);
+							if ( -1 == (int)value ) {
+								printf(err_timestamp_conversion, tokens[GF_ROW_INDEX], file_rows_count);
+								reader_close(reader);
+								free(rows);
+								return NULL;
+							}
+							if ( value >= DATASET_YEARS_MAX * (366 * 24 * 60 / calendar->step) ) {
+								printf(err_span_too_long, file_rows_count, DATASET_YEARS_MAX);
+								reader_close(reader);
+								free(rows);
 								return NULL;
 							}
-							value = j;
 						} else {
 							/* convert token */
 							value = convert_string_to_prec(token, &error);
 							if ( error ) {
-								printf(err_conversion, token, i+1, datasets[file].rows_count);
-								free_datasets(datasets, list_count);
-								fclose(f);
+								printf(err_conversion, token, i+1, file_rows_count);
+								reader_close(reader);
+								free(rows);
 								return NULL;
 							}
 						}
@@ -320,7 +383,7 @@ ROW *import_dataset(const LIST *const list, const int list_count, int *const row
 						}
 
 						/* assign value */
-						datasets[file].rows[datasets[file].rows_count-1].value[y] = value;
+						values[y] = value;
 
 						/* update counter */
 						++assigned_required_values_count;
@@ -329,232 +392,122 @@ ROW *import_dataset(const LIST *const list, const int list_count, int *const row
 			}
 
 			/* check if all required values have been imported */
-			if ( assigned_required_values_count != GF_REQUIRED_DATASET_VALUES ) {
-				printf(err_unable_to_import_all_values, datasets[file].rows_count); 
-				free_datasets(datasets, list_count);
-				fclose(f);
+			if ( reader_has_error(reader) ) {
+				printf(err_unable_read_file, list[file].name);
+				reader_close(reader);
+				free(rows);
 				return NULL;
 			}
-		}
-
-		/* close file */
-		fclose(f);
-	}
-
-	/* save imported file for debugging purposes */
-#ifdef _DEBUG
-	{
-		for ( file = 0; file < list_count; file++ ) {
-			char buf[256];
-			FILE* s;
-
-			sprintf(buf, "dataset_debug_%02d.csv", file+1);
-			s = fopen(buf, "w");
-			if ( ! s ) {
-				printf(err_unable_to_create_debug_file, buf); 
-				free_datasets(datasets, list_count);
-				fclose(f);
+			if ( assigned_required_values_count != GF_REQUIRED_DATASET_VALUES ) {
+				printf(err_unable_to_import_all_values, file_rows_count);
+				reader_close(reader);
+				free(rows);
 				return NULL;
 			}
-			fputs("ROW_INDEX,", f);
-			fprintf(f, "%s,", tokens[GF_TOFILL]);
-			fprintf(f, "%s,", tokens[GF_DRIVER_1]);
-			fprintf(f, "%s,", tokens[GF_DRIVER_2A]);
-			fprintf(f, "%s\n", tokens[GF_DRIVER_2B]);
-			for ( i = 0; i < datasets[file].rows_count; ++i ) {
-				fprintf(f, "%g,%g,%g,%g,%g\n"
-							, datasets[file].rows[i].value[GF_ROW_INDEX]
-							, datasets[file].rows[i].value[GF_TOFILL]
-							, datasets[file].rows[i].value[GF_DRIVER_1]
-							, datasets[file].rows[i].value[GF_DRIVER_2A]
-							, datasets[file].rows[i].value[GF_DRIVER_2B]
-				);
-			}
-			fclose(s);
-		}
-	}
-#endif
-
-	/* create clean dataset */
-	j = 0;
-	rows = NULL;
-	for ( file = 0; file < list_count; file++ ) {
-		/* get number of rows by year */
-		i = get_rows_count_by_timeres(timeres, years[file]);
-
-		/* check if imported rows are > than year's rows count */
-		if ( datasets[file].rows_count > i ) {
-            printf(err_too_many_rows, datasets[file].rows_count, i);
-            free(rows);
-            free_datasets(datasets, list_count);
-            return NULL;
-		}
 
-		/* parse timestamps */
-		{
-			int freq; /* timeres */
-			int row;
-
-			for( z = 0; z < datasets[file].rows_count; ++z ) {
-				if ( ! check_timestamp(&datasets[file].timestamps[z]) ) {
-					printf(err_invalid_timestamp, z+1
-								, datasets[file].timestamps[z].YYYY
-								, datasets[file].timestamps[z].MM
-								, datasets[file].timestamps[z].DD
-								, datasets[file].timestamps[z].hh
-								, datasets[file].timestamps[z].mm
-								, datasets[file].timestamps[z].ss
-					);
-					free(rows);
-					free_datasets(datasets, list_count);
-					return NULL;
+			/* get timeres by timestamps differences */
+			if ( file_rows_count > 1 ) {
+				i = timestamp_difference_in_seconds(&current, &previous);
+				if ( (2 == file_rows_count) || (i < freq) ) {
+					freq = i;
+					freq_row = file_rows_count-2;
 				}
 			}
+			previous = current;
 
-			/* get timeres by timestamps differences */
-			freq = timestamp_difference_in_seconds(&datasets[file].timestamps[1], &datasets[file].timestamps[0]);
-			row = 0;
-			for( z = 1; z < datasets[file].rows_count-1; ++z ) {
-				int diff;
-
-				diff = timestamp_difference_in_seconds(&datasets[file].timestamps[z+1], &datasets[file].timestamps[z]);
-
-				if ( diff < freq ) {
-					freq = diff;
-					row = z;
+			/* alloc rows if needed */
+			y = (int)values[GF_ROW_INDEX];
+			if ( y >= allocated_rows_count ) {
+				rows = grow_rows(rows, &allocated_rows_count, y+1);
+				if ( !rows ) {
+					reader_close(reader);
+					return NULL;
 				}
 			}
+			if ( y >= calendar->rows_count ) {
+				calendar->rows_count = y+1;
+			}
 
-			/* check timeres */
-			freq /= 60;
-			{
-				int err;
-
-				err = 0;
-				switch ( timeres )
-				{
-					case QUATERHOURLY_TIMERES:
-						if ( freq != 15 ) err = 1;
-					break;
-
-					case HALFHOURLY_TIMERES:
-						if ( freq != 30 ) err = 1;
-					break;
-
-					case HOURLY_TIMERES:
-						if ( freq != 60 ) err = 1;
-					break;
-				}
+			/* check if row was already assigned */
+			if ( rows[y].assigned ) {
+				printf(err_row_assigned, file_rows_count);
+				reader_close(reader);
+				free(rows);
+				return NULL;
+			}
 
-				if ( err ) {
-					printf(err_invalid_freq, row);
-					free(rows);
-					free_datasets(datasets, list_count);
-					return NULL;
-				}
+			/* assign values */
+			for ( i = 0; i < GF_REQUIRED_DATASET_VALUES; i++ ) {
+				rows[y].value[i] = values[i];
 			}
+			rows[y].assigned = 1;
 		}
 
-		/* alloc memory */
-		rows_no_leak = realloc(rows, (j+i)*sizeof*rows_no_leak);
-		if ( !rows_no_leak ) {
-			puts(err_out_of_memory);
+		/* updated on October 18, 2026: a broken file is not a short one */
+		if ( reader_has_error(reader) ) {
+			printf(err_unable_read_file, list[file].name);
+			reader_close(reader);
 			free(rows);
-			free_datasets(datasets, list_count);
 			return NULL;
 		}
 
-		/* assign pointer */
-		rows = rows_no_leak;
+		/* close file */
+		reader_close(reader);
 
-		/* reset newly rows */
-		for ( y = 0; y < i; y++ ) {
-			for ( z = 0; z < GF_REQUIRED_DATASET_VALUES; z++ ) {
-				if ( GF_ROW_INDEX == z ) {
-					rows[j+y].value[z] = j+y;
-				} else {
-					rows[j+y].value[z] = INVALID_VALUE;
-				}
-			}
-			rows[j+y].assigned = 0;
+		/* no rows ? */
+		if ( !file_rows_count ) {
+			puts(err_empty_file);
+			free(rows);
+			return NULL;
 		}
 
-		/* assign rows */
-		{
-			int old_year;
-			int k;
-
-			z = i;
-			k = 0;
-			old_year = datasets[file].timestamps[0].YYYY;
-			for ( i = 0; i < datasets[file].rows_count; i++ ) {
-				y = (int)datasets[file].rows[i].value[GF_ROW_INDEX];
-
-				if ( (old_year != datasets[file].timestamps[i].YYYY)
-						&& (
-							(datasets[file].timestamps[i].MM != 1)
-							|| (datasets[file].timestamps[i].DD != 1)
-							|| (datasets[file].timestamps[i].hh != 0)
-							|| (datasets[file].timestamps[i].mm != 0)
-							)
-				) {
-					old_year = datasets[file].timestamps[i].YYYY;
-					k += get_rows_count_by_timeres(timeres, old_year);
-				}
-				
-				/* check row index */
-				if ( (y < 0) || (y >= z) ) {
-					printf(err_invalid_index, tokens[GF_ROW_INDEX], i+1);
-					free(rows);
-					free_datasets(datasets, list_count);
-					return NULL;
-				}
-
-				/* check if row was already assigned */
-				if ( rows[j+y+k].assigned ) {
-					printf(err_row_assigned, i+1);
-					free(rows);
-					free_datasets(datasets, list_count);
-					return NULL;
-				}
+		/* check timeres */
+		if ( (file_rows_count < 2) || ! check_timeres(freq / 60) ) {
+			printf(err_invalid_freq, freq_row);
+			free(rows);
+			return NULL;
+		}
+	}
 
-				/* assign values */
-				rows[j+y+k].value[GF_TOFILL] = datasets[file].rows[i].value[GF_TOFILL];
-				rows[j+y+k].value[GF_DRIVER_1] = datasets[file].rows[i].value[GF_DRIVER_1];
-				rows[j+y+k].value[GF_DRIVER_2A] = datasets[file].rows[i].value[GF_DRIVER_2A];
-				rows[j+y+k].value[GF_DRIVER_2B] = datasets[file].rows[i].value[GF_DRIVER_2B];
-				rows[j+y+k].value[GF_ROW_INDEX] = datasets[file].rows[i].value[GF_ROW_INDEX];
-				rows[j+y+k].assigned = 1;
+	/* pad last year */
+	if ( full_years ) {
+		i = calendar->start + (calendar->rows_count - 1) * calendar->step;
+		i = (get_year_begin_in_minutes(i, calendar->step, 1) - calendar->start) / calendar->step + 1;
+		if ( i > allocated_rows_count ) {
+			rows = grow_rows(rows, &allocated_rows_count, i);
+			if ( !rows ) {
+				return NULL;
 			}
 		}
+		calendar->rows_count = i;
+	}
 
-		/* keep track of allocated rows */
-		j += z;
+	/* free unused rows */
+	if ( calendar->rows_count < allocated_rows_count ) {
+		rows_no_leak = realloc(rows, calendar->rows_count*sizeof*rows_no_leak);
+		if ( rows_no_leak ) {
+			rows = rows_no_leak;
+		}
 	}
-	//assert(*rows_count == j);
-	*rows_count = j;
 
 	/* save imported file for debugging purposes */
 #ifdef _DEBUG
 	{
-		char buf[256];
 		FILE* s;
 
-		sprintf(buf, "dataset_debug_clean.csv");
-		s = fopen(buf, "w");
+		s = fopen(debug_file, "w");
 		if ( ! s ) {
-			printf(err_unable_to_create_debug_file, buf); 
-			free_datasets(datasets, list_count);
-			fclose(f);
+			printf(err_unable_to_create_debug_file, debug_file);
+			free(rows);
 			return NULL;
 		}
-		fputs("ROW_INDEX,", f);
-		fprintf(f, "%s,", tokens[GF_TOFILL]);
-		fprintf(f, "%s,", tokens[GF_DRIVER_1]);
-		fprintf(f, "%s,", tokens[GF_DRIVER_2A]);
-		fprintf(f, "%s\n", tokens[GF_DRIVER_2B]);
-		for ( i = 0; i < *rows_count; ++i ) {
-			fprintf(f, "%g,%g,%g,%g,%g\n"
+		fputs("ROW_INDEX,", s);
+		fprintf(s, "%s,", tokens[GF_TOFILL]);
+		fprintf(s, "%s,", tokens[GF_DRIVER_1]);
+		fprintf(s, "%s,", tokens[GF_DRIVER_2A]);
+		fprintf(s, "%s\n", tokens[GF_DRIVER_2B]);
+		for ( i = 0; i < calendar->rows_count; ++i ) {
+			fprintf(s, "%g,%g,%g,%g,%g\n"
 						, rows[i].value[GF_ROW_INDEX]
 						, rows[i].value[GF_TOFILL]
 						, rows[i].value[GF_DRIVER_1]
@@ -566,9 +519,6 @@ ROW *import_dataset(const LIST *const list, const int list_count, int *const row
 	}
 #endif
 
-	/* free memory */
-	free_datasets(datasets, list_count);
-
 	/* return pointer */
 	return rows;
 }
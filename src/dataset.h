@@ -28,8 +28,9 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 /* includes */
 #include "types.h"
+#include "prefetch.h"
 
 /* prototypes */
-ROW *import_dataset(const LIST *const list, const int count, int *const rows_count);
+ROW *import_dataset(const LIST *const list, const int count, CALENDAR *const calendar, char *const tofill, PREFETCH *const prefetch);
 
 #endif /* DATASET_H */
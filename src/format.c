@@ -0,0 +1,187 @@
+/*
+	format.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	fast output formatting, added on October 18, 2026
+
+	format_double gives exactly the same text as printf "%g", so output
+	files are unchanged. integers and values in [1e-4, 1e6) are formatted
+	here, everything else (and values too close to a rounding tie to be
+	sure about the last digit) falls back to snprintf.
+*/
+
+/* includes */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "format.h"
+
+/* constants */
+#define SIGNIFICANT_DIGITS		6	/* default %g precision */
+#define TIE_EPSILON				1e-6
+
+/* */
+static const double powers_of_ten[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+};
+
+/* lower bound of each decimal exponent from -4 to 5 */
+static const double exponents_min[] = {
+	1e-4, 1e-3, 1e-2, 1e-1, 1e0, 1e1, 1e2, 1e3, 1e4, 1e5
+};
+
+/* writes value backward ending at p, returns digits count */
+static int format_unsigned_backward(char *p, unsigned int value) {
+	int n;
+
+	n = 0;
+	do {
+		*--p = '0' + value % 10;
+		value /= 10;
+		++n;
+	} while ( value );
+
+	return n;
+}
+
+/* */
+int format_int(char *const p, const int value) {
+	int i;
+	int n;
+	unsigned int u;
+	char buffer[FORMAT_INT_SIZE];
+
+	i = 0;
+	u = value;
+	if ( value < 0 ) {
+		p[i++] = '-';
+		u = 0U - u;
+	}
+	n = format_unsigned_backward(buffer+FORMAT_INT_SIZE, u);
+	memcpy(p+i, buffer+FORMAT_INT_SIZE-n, n);
+
+	return i + n;
+}
+
+/* */
+int format_double(char *const p, const double value) {
+	int i;
+	int e;
+	int n;
+	unsigned int m;
+	double a;
+	double scaled;
+	double frac;
+	char digits[SIGNIFICANT_DIGITS];
+
+	a = fabs(value);
+
+	/* integer fast path, up to SIGNIFICANT_DIGITS digits %g prints them as they are */
+	if ( (a < 1e6) && (a == (int)a) ) {
+		i = 0;
+		if ( (value < 0) || ((0 == value) && (1 / value < 0)) ) {
+			p[i++] = '-';
+		}
+		return i + format_int(p+i, (int)a);
+	}
+
+	/* out of fixed notation range, nan or inf */
+	if ( !(a >= 1e-4 && a < 1e6) ) {
+		return snprintf(p, FORMAT_DOUBLE_SIZE, "%g", value);
+	}
+
+	/* decimal exponent */
+	for ( e = 5; a < exponents_min[e+4]; e-- );
+
+	/* scale to SIGNIFICANT_DIGITS digits and round to nearest */
+	scaled = a * powers_of_ten[SIGNIFICANT_DIGITS-1-e];
+	m = (unsigned int)scaled;
+	frac = scaled - m;
+	if ( fabs(frac - 0.5) < TIE_EPSILON ) {
+		return snprintf(p, FORMAT_DOUBLE_SIZE, "%g", value);
+	}
+	if ( frac > 0.5 ) {
+		++m;
+	}
+	if ( m >= 1000000 ) {
+		m /= 10;
+		if ( ++e >= 6 ) {
+			return snprintf(p, FORMAT_DOUBLE_SIZE, "%g", value);
+		}
+	}
+
+	for ( i = SIGNIFICANT_DIGITS-1; i >= 0; i-- ) {
+		digits[i] = '0' + m % 10;
+		m /= 10;
+	}
+
+	/* strip trailing zeros */
+	for ( n = SIGNIFICANT_DIGITS; (n > e+1) && ('0' == digits[n-1]); n-- );
+
+	i = 0;
+	if ( value < 0 ) {
+		p[i++] = '-';
+	}
+	if ( e >= 0 ) {
+		memcpy(p+i, digits, e+1);
+		i += e+1;
+		if ( n > e+1 ) {
+			p[i++] = '.';
+			memcpy(p+i, digits+e+1, n-e-1);
+			i += n-e-1;
+		}
+	} else {
+		p[i++] = '0';
+		p[i++] = '.';
+		for ( e = -e-1; e > 0; e-- ) {
+			p[i++] = '0';
+		}
+		memcpy(p+i, digits, n);
+		i += n;
+	}
+
+	return i;
+}
+
+/* */
+int format_timestamp(char *const p, const TIMESTAMP *const t) {
+	int y;
+
+	y = t->YYYY;
+	p[3] = '0' + y % 10; y /= 10;
+	p[2] = '0' + y % 10; y /= 10;
+	p[1] = '0' + y % 10; y /= 10;
+	p[0] = '0' + y % 10;
+	p[4] = '0' + t->MM / 10;
+	p[5] = '0' + t->MM % 10;
+	p[6] = '0' + t->DD / 10;
+	p[7] = '0' + t->DD % 10;
+	p[8] = '0' + t->hh / 10;
+	p[9] = '0' + t->hh % 10;
+	p[10] = '0' + t->mm / 10;
+	p[11] = '0' + t->mm % 10;
+
+	return FORMAT_TIMESTAMP_SIZE;
+}
@@ -0,0 +1,1342 @@
+/*
+	gfmds.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	gapfilling engine, moved from common.c on October 18, 2026
+
+	it is built in gf_mds and as libgfmds (see Makefile), so it must not
+	use global variables or anything outside this file but macros of
+	common.h. public interface is in gfmds.h
+*/
+
+/* includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "common.h"
+#if defined (GF_STATS)
+#if defined (_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#endif
+
+/* error strings */
+static const char err_out_of_memory_gf[] = "out of memory";
+static const char err_gf_too_less_values[] = "too few valid values to apply gapfilling\n";
+static const char *const error_strings[GFMDS_ERRORS] = {
+	"no error",
+	"invalid parameters",
+	"out of memory",
+	"too few valid values to apply gapfilling",
+	"stopped by rows callback",
+};
+
+#if defined (GF_STATS)
+/* added on October 18, 2026: wall seconds from an unspecified start */
+static double get_wall_time(void) {
+#if defined (_WIN32)
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart / frequency.QuadPart;
+#else
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+#endif
+}
+
+/* added on October 18, 2026: cpu seconds of calling thread */
+static double get_cpu_time(void) {
+#if defined (_WIN32)
+	FILETIME creation;
+	FILETIME exit;
+	FILETIME kernel;
+	FILETIME user;
+
+	if ( !GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user) ) {
+		return 0;
+	}
+	return (((double)kernel.dwHighDateTime + user.dwHighDateTime) * 4294967296.0 + (double)kernel.dwLowDateTime + user.dwLowDateTime) * 1e-7;
+#else
+	struct timespec t;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+#endif
+}
+#endif /* GF_STATS */
+
+/* value of row in column c */
+#define COLUMN_VALUE(c,r)	(*(const PREC *)(((const char *)(c)->values)+(r)*(c)->stride))
+
+/* timeres values of common.h must be the public ones */
+typedef char timeres_check[(((int)QUATERHOURLY_TIMERES == (int)GFMDS_QUATERHOURLY) && ((int)HOURLY_TIMERES == (int)GFMDS_HOURLY)) ? 1 : -1];
+
+/* structures */
+/* added on October 18, 2026: window rows compared and similar rows found by gapfill */
+typedef struct {
+	PREC work;
+	PREC candidates;
+} COUNTERS;
+
+/*
+	added on October 18, 2026: cascade of gapfill calls for a row,
+	end_window of -1 is end_row + 1. wide windows start at GF_STAGE_WIDE
+*/
+typedef struct {
+	int start;
+	int end;
+	int step;
+	int method;
+} STAGE;
+
+#define GF_STAGE_WIDE	3
+
+static const STAGE stages[GFMDS_STAGES] = {
+	{ 7, 14, 7, GF_ALL_METHOD },
+	{ 7, 7, 7, GF_VALUE1_METHOD },
+	{ 0, 2, 1, GF_TOFILL_METHOD },
+	{ 21, 77, 7, GF_ALL_METHOD },
+	{ 14, 77, 7, GF_VALUE1_METHOD },
+	{ 3, -1, 3, GF_TOFILL_METHOD },
+};
+
+/* added on October 18, 2026: receiver of finished rows */
+typedef struct {
+	GFMDS_ROWS_CALLBACK callback;
+	void *user_data;
+	int block_rows;
+} STREAM;
+
+/* added on October 18, 2026: receiver of runs of rows, see GFMDS_TRACE_RUN */
+typedef struct {
+	GFMDS_TRACE_CALLBACK callback;
+	void *user_data;
+} TRACER;
+
+/* */
+struct GFMDS_CONTEXT {
+	GFMDS_PARAMS params;
+	STREAM stream;
+	int no_gaps_filled_count;
+	int deferred_count;
+#if defined (GF_STATS)
+	GFMDS_STATS stats;
+	TRACER tracer;
+#endif
+};
+
+/* stats of a context, NULL if they are not collected */
+#if defined (GF_STATS)
+#define CONTEXT_STATS(c)	(&(c)->stats)
+#define CONTEXT_TRACER(c)	((c)->tracer.callback ? &(c)->tracer : NULL)
+#else
+#define CONTEXT_STATS(c)	NULL
+#define CONTEXT_TRACER(c)	NULL
+#endif
+
+#if defined (GF_STATS)
+/* added on October 18, 2026: passes run to tracer and empties it */
+static void trace_run_flush(const TRACER *const tracer, GFMDS_TRACE_RUN *const run) {
+	if ( run->rows_count ) {
+		tracer->callback(run, tracer->user_data);
+		run->rows_count = 0;
+	}
+}
+
+/* added on October 18, 2026: adds row to run, a run has consecutive rows that are all gaps or all not */
+static void trace_run_add(const TRACER *const tracer, GFMDS_TRACE_RUN *const run, const int row, const int gaps) {
+	if ( run->rows_count && ((run->gaps != gaps) || (run->first_row + run->rows_count != row)) ) {
+		trace_run_flush(tracer, run);
+	}
+	if ( !run->rows_count ) {
+		memset(run, 0, sizeof*run);
+		run->first_row = row;
+		run->gaps = gaps;
+		run->start = get_wall_time();
+		run->end = run->start;
+	}
+	++run->rows_count;
+}
+#endif
+
+/* */
+static int compare_similiar(const void * a, const void * b) {
+	if ( *(PREC *)a < *(PREC *)b ) {
+		return -1;
+	} else if ( *(PREC *)a > *(PREC *)b ) {
+		return 1;
+	} else {
+		return 0;
+	}
+}
+
+/* private function for gapfilling */
+static PREC gf_get_similiar_mean(const GF_ROW *const gf_rows, const int rows_count) {
+ 	int i;
+	PREC mean;
+
+	/* check parameter */
+	assert(gf_rows);
+
+	/* get mean */
+	mean = 0.0;
+	for ( i = 0; i < rows_count; i++ ) {
+		mean += gf_rows[i].similiar;
+	}
+	mean /= rows_count;
+
+	/* check for NAN */
+	if ( mean != mean ) {
+		mean = INVALID_VALUE;
+	}
+
+	/* */
+	return mean;
+}
+
+/* gapfilling */
+PREC gf_get_similiar_standard_deviation(const GF_ROW *const gf_rows, const int rows_count) {
+	int i;
+	PREC mean;
+	PREC sum;
+	PREC sum2;
+
+	/* check parameter */
+	assert(gf_rows);
+
+	/* get mean */
+	mean = gf_get_similiar_mean(gf_rows, rows_count);
+	if ( IS_INVALID_VALUE(mean) ) {
+		return INVALID_VALUE;
+	}
+
+	/* compute standard deviation */
+	sum = 0.0;
+	sum2 = 0.0;
+	for ( i = 0; i < rows_count; i++ ) {
+		sum = (gf_rows[i].similiar - mean);
+		sum *= sum;
+		sum2 += sum;
+	}
+	sum2 /= rows_count-1;
+	sum2 = (PREC)SQRT(sum2);
+
+	/* check for NAN */
+	if ( sum2 != sum2 ) {
+		sum2 = INVALID_VALUE;
+	}
+
+	/* */
+	return sum2;
+}
+
+/* gapfilling */
+PREC gf_get_similiar_median(const GF_ROW *const gf_rows, const int rows_count, int *const error) {
+	int i;
+	PREC *p_median;
+	PREC result;
+
+	/* check for null pointer */
+	assert(gf_rows);
+
+	/* reset */
+	*error = 0;
+
+	if ( !rows_count ) {
+		return INVALID_VALUE;
+	} else if ( 1 == rows_count ) {
+		return gf_rows[0].similiar;
+	}
+
+	/* get valid values */
+	p_median = malloc(rows_count*sizeof*p_median);
+	if ( !p_median ) {
+		*error = 1;
+		return INVALID_VALUE;
+	}
+	for ( i = 0; i < rows_count; i++ ) {
+		p_median[i] = gf_rows[i].similiar;
+	}
+
+	/* sort values */
+	qsort(p_median, rows_count, sizeof *p_median, compare_similiar);
+
+	/* get median */
+	if ( rows_count & 1 ) {
+		result = p_median[((rows_count+1)/2)-1];
+	} else {
+		result = ((p_median[(rows_count/2)-1] + p_median[rows_count/2]) / 2);
+	}
+
+	/* free memory */
+	free(p_median);
+
+	/* check for NAN */
+	if ( result != result ) {
+		result = INVALID_VALUE;
+	}
+
+	/* */
+	return result;
+}
+
+/* private function for gapfilling */
+static int gapfill(	const GFMDS_COLUMN *const columns,
+					GF_ROW *const gf_rows,
+					const int start_window,
+					const int end_window,
+					const int current_row,
+					const int start,
+					const int end,
+					const int step,
+					const int method,
+					const int timeres,
+					const PREC value1_tolerance_min,
+					const PREC value1_tolerance_max,
+					const PREC value2_tolerance_min,
+					const PREC value2_tolerance_max,
+					const PREC value3_tolerance_min,
+					const PREC value3_tolerance_max,
+					COUNTERS *const counters) {
+	int i;
+	int y;
+	int j;
+	int z;
+	int window;
+	int window_start;
+	int window_end;
+	int window_current;
+	int samples_count;
+	PREC value1_tolerance;
+	PREC value2_tolerance;
+	PREC value3_tolerance;
+	PREC row_value1;
+	PREC row_value2;
+	PREC row_value3;
+	/* local copies, stores on gf_rows could alias columns */
+	const GFMDS_COLUMN tofill = columns[GFMDS_COLUMN_TOFILL];
+	const GFMDS_COLUMN value1 = columns[GFMDS_COLUMN_DRIVER1];
+	const GFMDS_COLUMN value2 = columns[GFMDS_COLUMN_DRIVER2A];
+	const GFMDS_COLUMN value3 = columns[GFMDS_COLUMN_DRIVER2B];
+
+	/* check parameter */
+	assert(columns && gf_rows && counters && (method >=0 && method < GF_METHODS));
+	assert((timeres > SPOT_TIMERES) && (timeres <= HOURLY_TIMERES));
+
+	/* reset */
+	window = 0;
+	window_start = 0;
+	window_end = 0;
+	window_current = 0;
+	samples_count = 0;
+	value1_tolerance = value1_tolerance_min;
+	value2_tolerance = value2_tolerance_min;
+	value3_tolerance = value3_tolerance_min;
+	row_value1 = COLUMN_VALUE(&value1, current_row);
+	row_value2 = COLUMN_VALUE(&value2, current_row);
+	row_value3 = COLUMN_VALUE(&value3, current_row);
+
+	/* modified on January 17, 2018 */
+	/* j is and index checker for timeres */
+	switch ( timeres ) {
+		case QUATERHOURLY_TIMERES:
+			j = 9;
+		break;
+
+		case HALFHOURLY_TIMERES:
+			j = 5;
+		break;
+
+		case HOURLY_TIMERES:
+			j = 3;
+		break;
+	}
+
+	/* */
+	i = start;
+	if ( GF_TOFILL_METHOD == method ) {
+		/* modified on January 17, 2018 */
+		switch ( timeres ) {
+			case QUATERHOURLY_TIMERES:
+				z = 96;
+			break;
+
+			case HALFHOURLY_TIMERES:
+				z = 48;
+			break;
+
+			case HOURLY_TIMERES:
+				z = 24;
+			break;
+		}
+	} else {
+		z = 1;
+	}
+	while ( i <= end ) {
+		/* reset */
+		samples_count = 0;
+
+		/* compute window */
+		/* modified on January 17, 2018 */
+		switch ( timeres ) {
+			case QUATERHOURLY_TIMERES:
+				window = 96 * i;
+			break;
+
+			case HALFHOURLY_TIMERES:
+				window = 48 * i;
+			break;
+
+			case HOURLY_TIMERES:
+				window = 24 * i;
+			break;
+		}
+
+		/* get window start index */
+		window_start = current_row - window;
+		if ( GF_TOFILL_METHOD == method ) {
+			/* modified on January 17, 2018 */
+			switch ( timeres ) {
+				case QUATERHOURLY_TIMERES:
+					window_start -= 4;
+				break;
+
+				case HALFHOURLY_TIMERES:
+					window_start -= 2;
+				break;
+
+				case HOURLY_TIMERES:
+					window_start -= 1;
+				break;
+			}
+		}
+
+		if ( GF_TOFILL_METHOD != method ) {
+			/* fix for recreate markus code */
+			++window_start;
+		}
+
+		/* get window end index */
+		window_end = current_row + window;
+		if (GF_TOFILL_METHOD == method ) {
+			/* modified on January 17, 2018 */
+			switch ( timeres ) {
+				case QUATERHOURLY_TIMERES:
+					window_end += 5;
+				break;
+
+				case HALFHOURLY_TIMERES:
+					window_end += 3;
+				break;
+
+				case HOURLY_TIMERES:
+					window_end += 2;
+				break;
+			}
+		}
+
+		/*	fix bounds for first two methods
+			cause in hour method (NEE_METHOD) a window start at -32 and window end at 69,
+			it will be fixed to window start at 0 and this is an error...
+		*/
+		if ( GF_TOFILL_METHOD != method ) {
+			if ( window_start < 0 ) {
+				window_start = 0;
+			}
+
+			if ( window_end > end_window ) {
+				window_end = end_window;
+			}
+
+			/* modified on June 25, 2013 */
+			/* compute tolerance for value1 */
+			if ( IS_INVALID_VALUE(value1_tolerance_min) ) {
+				value1_tolerance = value1_tolerance_max;
+			} else if ( IS_INVALID_VALUE(value1_tolerance_max) ) {
+				value1_tolerance = value1_tolerance_min;
+			} else {
+				value1_tolerance = row_value1;
+				if ( value1_tolerance < value1_tolerance_min ) {
+					value1_tolerance = value1_tolerance_min;
+				} else if ( value1_tolerance > value1_tolerance_max ) {
+					value1_tolerance = value1_tolerance_max;
+				}
+			}
+
+			/* modified on January 17, 2018 */
+			/* compute tolerance for value2 */
+			if ( IS_INVALID_VALUE(value2_tolerance_min) ) {
+				value2_tolerance = GF_DRIVER_2A_TOLERANCE_MIN;
+			} else if ( ! IS_INVALID_VALUE(value2_tolerance_max) ) {
+				value2_tolerance = row_value2;
+				if ( value2_tolerance < value2_tolerance_min ) {
+					value2_tolerance = value2_tolerance_min;
+				} else if ( value2_tolerance > value2_tolerance_max ) {
+					value2_tolerance = value2_tolerance_max;
+				}
+			}
+
+			/* modified on January 17, 2018 */
+			/* compute tolerance for value3 */
+			if ( IS_INVALID_VALUE(value3_tolerance_min) ) {
+				value3_tolerance = GF_DRIVER_2B_TOLERANCE_MIN;
+			} else if ( ! IS_INVALID_VALUE(value3_tolerance_max) ) {
+				value3_tolerance = row_value3;
+				if ( value3_tolerance < value3_tolerance_min ) {
+					value3_tolerance = value3_tolerance_min;
+				} else if ( value3_tolerance > value3_tolerance_max ) {
+					value3_tolerance = value3_tolerance_max;
+				}
+			}
+		}
+
+		assert(! IS_INVALID_VALUE(value1_tolerance));
+		assert(! IS_INVALID_VALUE(value2_tolerance));
+		assert(! IS_INVALID_VALUE(value3_tolerance));
+
+		/* loop through window */
+		for ( window_current = window_start; window_current < window_end; window_current += z ) {
+			switch ( method ) {
+				case GF_ALL_METHOD:
+					if ( IS_FLAG_SET(gf_rows[window_current].mask, GF_ALL_VALID) ) {
+						if (
+								(FABS(COLUMN_VALUE(&value2, window_current)-row_value2) < value2_tolerance) &&
+								(FABS(COLUMN_VALUE(&value1, window_current)-row_value1) < value1_tolerance) &&
+								(FABS(COLUMN_VALUE(&value3, window_current)-row_value3) < value3_tolerance)
+							) {
+							gf_rows[samples_count++].similiar = COLUMN_VALUE(&tofill, window_current);
+						}
+					}
+				break;
+
+				case GF_VALUE1_METHOD:
+					if ( IS_FLAG_SET(gf_rows[window_current].mask, (GF_TOFILL_VALID|GF_VALUE1_VALID)) ) {
+						if ( FABS(COLUMN_VALUE(&value1, window_current)-row_value1) < value1_tolerance ) {
+							gf_rows[samples_count++].similiar = COLUMN_VALUE(&tofill, window_current);
+						}
+					}
+				break;
+
+				case GF_TOFILL_METHOD:
+					for ( y = 0; y < j; y++ ) {
+						if ( ((window_current+y) < 0) || (window_current+y) >= end_window ) {
+							continue;
+						}
+						if ( IS_FLAG_SET(gf_rows[window_current+y].mask, GF_TOFILL_VALID) ) {
+							gf_rows[samples_count++].similiar = COLUMN_VALUE(&tofill, window_current+y);
+						}
+					}
+				break;
+			}
+		}
+		counters->work += window_end - window_start;
+		counters->candidates += samples_count;
+
+		if ( samples_count > 1 ) {
+			/* set mean */
+			gf_rows[current_row].filled = gf_get_similiar_mean(gf_rows, samples_count);
+
+			/* set standard deviation */
+			gf_rows[current_row].stddev = gf_get_similiar_standard_deviation(gf_rows, samples_count);
+
+			/* set method */
+			gf_rows[current_row].method = method + 1;
+
+			/* set time-window */
+			gf_rows[current_row].time_window = i * 2;
+
+			/* fix hour method timewindow */
+			if ( GF_TOFILL_METHOD == method ) {
+				++gf_rows[current_row].time_window;
+			}
+
+			/* set samples */
+			gf_rows[current_row].samples_count = samples_count;
+
+			/* ok */
+			return 1;
+		}
+
+		/* inc loop */
+		i += step;
+
+		/* break if window bigger than  */
+		if ( (window_start < start_window) && (window_end > end_window) ) {
+			break;
+		}
+	}
+
+	/* */
+	return 0;
+}
+
+/* added on October 18, 2026: resets rows and sets masks, returns valid values to fill */
+static int set_masks(	const GFMDS_PARAMS *const params,
+						const GFMDS_COLUMN *const columns,
+						const int rows_count,
+						GF_ROW *const gf_rows,
+						const int start_row,
+						const int end_row) {
+	int i;
+	int valids_count;
+
+	/* reset */
+	for ( i = 0; i < rows_count; i++ ) {
+		gf_rows[i].mask = 0;
+		gf_rows[i].similiar = INVALID_VALUE;
+		gf_rows[i].stddev = INVALID_VALUE;
+		gf_rows[i].filled = INVALID_VALUE;
+		gf_rows[i].quality = INVALID_VALUE;
+		gf_rows[i].time_window = 0;
+		gf_rows[i].samples_count = 0;
+		gf_rows[i].method = 0;
+	}
+
+	/* update mask and count valids TO FILL */
+	valids_count = 0;
+	for ( i = start_row; i < end_row; i++ ) {
+		if ( !IS_INVALID_VALUE(COLUMN_VALUE(&columns[GFMDS_COLUMN_TOFILL], i)) ) {
+			gf_rows[i].mask |= GF_TOFILL_VALID;
+		}
+		if ( !IS_INVALID_VALUE(COLUMN_VALUE(&columns[GFMDS_COLUMN_DRIVER1], i)) ) {
+			gf_rows[i].mask |= GF_VALUE1_VALID;
+		}
+		if ( !IS_INVALID_VALUE(COLUMN_VALUE(&columns[GFMDS_COLUMN_DRIVER2A], i)) ) {
+			gf_rows[i].mask |= GF_VALUE2_VALID;
+		}
+		if ( !IS_INVALID_VALUE(COLUMN_VALUE(&columns[GFMDS_COLUMN_DRIVER2B], i)) ) {
+			gf_rows[i].mask |= GF_VALUE3_VALID;
+		}
+
+		/* check for QC */
+		if (	!IS_INVALID_VALUE(params->qc_thrs) &&
+				columns[GFMDS_COLUMN_DRIVER1_QC].values &&
+				!IS_INVALID_VALUE(COLUMN_VALUE(&columns[GFMDS_COLUMN_DRIVER1_QC], i)) ) {
+			if ( COLUMN_VALUE(&columns[GFMDS_COLUMN_DRIVER1_QC], i) > params->qc_thrs ) {
+				gf_rows[i].mask &= ~GF_VALUE1_VALID;
+			}
+		}
+
+		if (	!IS_INVALID_VALUE(params->qc_thrs) &&
+				columns[GFMDS_COLUMN_DRIVER2A_QC].values &&
+				!IS_INVALID_VALUE(COLUMN_VALUE(&columns[GFMDS_COLUMN_DRIVER2A_QC], i)) ) {
+			if ( COLUMN_VALUE(&columns[GFMDS_COLUMN_DRIVER2A_QC], i) > params->qc_thrs ) {
+				gf_rows[i].mask &= ~GF_VALUE2_VALID;
+			}
+		}
+
+		if (	!IS_INVALID_VALUE(params->qc_thrs) &&
+				columns[GFMDS_COLUMN_DRIVER2B_QC].values &&
+				!IS_INVALID_VALUE(COLUMN_VALUE(&columns[GFMDS_COLUMN_DRIVER2B_QC], i)) ) {
+			if ( COLUMN_VALUE(&columns[GFMDS_COLUMN_DRIVER2B_QC], i) > params->qc_thrs ) {
+				gf_rows[i].mask &= ~GF_VALUE3_VALID;
+			}
+		}
+
+		if ( IS_FLAG_SET(gf_rows[i].mask, GF_TOFILL_VALID) ) {
+			++valids_count;
+		}
+	}
+
+	return valids_count;
+}
+
+/*
+	fills rows between start_row and end_row of params, columns
+	of params are not used. gf_rows must hold rows_count rows,
+	finished rows are passed to stream (if any) in blocks.
+	when work_budget of params is spent wide windows are skipped and
+	rows are deferred, refine fills only deferred rows of a previous run.
+	returns GFMDS_OK or an error
+*/
+static int gf_mds_run(	const GFMDS_PARAMS *const params,
+						const GFMDS_COLUMN *const columns,
+						const int rows_count,
+						GF_ROW *const gf_rows,
+						const STREAM *const stream,
+						const int refine,
+						int *const no_gaps_filled_count,
+						int *const deferred_count,
+						GFMDS_STATS *const stats,
+						const TRACER *const tracer) {
+	int i;
+	int stage;
+	int filled;
+	int block_start;
+	COUNTERS counters;
+#if defined (GF_STATS)
+	double time;
+	double now;
+	COUNTERS previous;
+	GFMDS_TRACE_RUN run;
+	double fill_time;
+	double fill_cpu_time;
+#endif
+	int start_row;
+	int end_row;
+	PREC value1_tolerance_min;
+	PREC value1_tolerance_max;
+	PREC value2_tolerance_min;
+	PREC value2_tolerance_max;
+	PREC value3_tolerance_min;
+	PREC value3_tolerance_max;
+
+	/* */
+	assert(params && columns && rows_count && gf_rows && no_gaps_filled_count && deferred_count);
+
+	/* reset */
+#if defined (GF_STATS)
+	fill_time = get_wall_time();
+	fill_cpu_time = get_cpu_time();
+	if ( stats ) {
+		memset(stats, 0, sizeof*stats);
+	}
+	run.rows_count = 0;
+#else
+	(void)stats;
+	(void)tracer;
+#endif
+	counters.work = 0;
+	counters.candidates = 0;
+	if ( !refine ) {
+		*no_gaps_filled_count = 0;
+	}
+	*deferred_count = 0;
+	start_row = params->start_row;
+	end_row = params->end_row;
+	if ( start_row < 0  ) {
+		start_row = 0;
+	}
+	if ( -1 == end_row ) {
+		end_row = rows_count;
+	} else if ( end_row > rows_count ) {
+		end_row = rows_count;
+	}
+	value1_tolerance_min = params->driver1_tolerance_min;
+	value1_tolerance_max = params->driver1_tolerance_max;
+	value2_tolerance_min = params->driver2a_tolerance_min;
+	value2_tolerance_max = params->driver2a_tolerance_max;
+	value3_tolerance_min = params->driver2b_tolerance_min;
+	value3_tolerance_max = params->driver2b_tolerance_max;
+
+	/* rows, masks and values_min are those of previous run on refine */
+	if ( !refine ) {
+#if defined (GF_STATS)
+		time = get_wall_time();
+#endif
+		if ( set_masks(params, columns, rows_count, gf_rows, start_row, end_row) < params->values_min ) {
+			return GFMDS_ERR_TOO_FEW_VALUES;
+		}
+#if defined (GF_STATS)
+		if ( stats ) {
+			stats->masks_time = get_wall_time() - time;
+		}
+#endif
+	}
+
+	/* modified on January 17, 2018 */
+	if ( IS_INVALID_VALUE(value1_tolerance_min) && IS_INVALID_VALUE(value1_tolerance_max) ) {
+		value1_tolerance_min = GF_DRIVER_1_TOLERANCE_MIN;
+		value1_tolerance_max = GF_DRIVER_1_TOLERANCE_MAX;
+	} else if ( IS_INVALID_VALUE(value1_tolerance_min) ) {
+		value1_tolerance_min = GF_DRIVER_1_TOLERANCE_MIN;
+	} else if ( IS_INVALID_VALUE(value1_tolerance_max) ) {
+		value1_tolerance_max = INVALID_VALUE;
+	}
+
+	/* modified on January 17, 2018 */
+	if ( IS_INVALID_VALUE(value2_tolerance_min) && IS_INVALID_VALUE(value2_tolerance_max) ) {
+		value2_tolerance_min = GF_DRIVER_2A_TOLERANCE_MIN;
+		value2_tolerance_max = GF_DRIVER_2A_TOLERANCE_MAX;
+	} else if ( IS_INVALID_VALUE(value2_tolerance_min) ) {
+		value2_tolerance_min = GF_DRIVER_2A_TOLERANCE_MIN;
+	} else if ( IS_INVALID_VALUE(value2_tolerance_max) ) {
+		value2_tolerance_max = INVALID_VALUE;
+	}
+
+	/* modified on January 17, 2018 */
+	if ( IS_INVALID_VALUE(value3_tolerance_min) && IS_INVALID_VALUE(value3_tolerance_max) ) {
+		value3_tolerance_min = GF_DRIVER_2B_TOLERANCE_MIN;
+		value3_tolerance_max = GF_DRIVER_2B_TOLERANCE_MAX;
+	} else if ( IS_INVALID_VALUE(value3_tolerance_min) ) {
+		value3_tolerance_min = GF_DRIVER_2B_TOLERANCE_MIN;
+	} else if ( IS_INVALID_VALUE(value3_tolerance_max) ) {
+		value3_tolerance_max = INVALID_VALUE;
+	}
+
+	/* loop for each row */
+	block_start = start_row;
+	for ( i = start_row; i < end_row; i++ ) {
+		/* rows before i are finished */
+		if ( stream && (i - block_start == stream->block_rows) ) {
+			if ( stream->callback(gf_rows+block_start, block_start, i-block_start, stream->user_data) ) {
+				return GFMDS_ERR_STOPPED;
+			}
+			block_start = i;
+		}
+
+		if ( refine ) {
+			if ( gf_rows[i].quality != GFMDS_QUALITY_DEFERRED ) {
+				continue;
+			}
+			gf_rows[i].quality = INVALID_VALUE;
+		}
+
+		/* copy value from TOFILL to FILLED */
+		gf_rows[i].filled = COLUMN_VALUE(&columns[GFMDS_COLUMN_TOFILL], i);
+
+		/* compute hat ? */
+		if ( !IS_INVALID_VALUE(gf_rows[i].filled) && !params->compute_hat ) {
+			continue;
+		}
+
+		/*	fill
+			Added 20140422: if a gap is impossible to fill, e.g. if with MDV there are no data in the whole dataset acquired in a range +/- one hour,
+			the data point is not filled and the qc is set to -9999
+		*/
+#if defined (GF_STATS)
+		if ( tracer ) {
+			trace_run_add(tracer, &run, i, !IS_FLAG_SET(gf_rows[i].mask, GF_TOFILL_VALID));
+		}
+#endif
+		filled = 0;
+		for ( stage = 0; !filled && (stage < GFMDS_STAGES); stage++ ) {
+			/* added on October 18, 2026: wide windows are deferred when budget is spent */
+			if ( (GF_STAGE_WIDE == stage) && !refine && (params->work_budget > 0) && (counters.work >= params->work_budget) ) {
+				break;
+			}
+#if defined (GF_STATS)
+			if ( stats ) {
+				time = get_wall_time();
+				previous = counters;
+			}
+#endif
+			filled = gapfill(	columns,
+								gf_rows,
+								start_row,
+								end_row,
+								i,
+								stages[stage].start,
+								(-1 == stages[stage].end) ? end_row + 1 : stages[stage].end,
+								stages[stage].step,
+								stages[stage].method,
+								params->timeres,
+								value1_tolerance_min,
+								value1_tolerance_max,
+								value2_tolerance_min,
+								value2_tolerance_max,
+								value3_tolerance_min,
+								value3_tolerance_max,
+								&counters
+			);
+#if defined (GF_STATS)
+			if ( stats ) {
+				now = get_wall_time();
+				stats->stage_time[stage] += now - time;
+				stats->rows_scanned[stage] += counters.work - previous.work;
+				stats->candidates[stage] += counters.candidates - previous.candidates;
+				++stats->rows_tried[stage];
+				stats->rows_filled[stage] += filled;
+				if ( tracer ) {
+					run.stage_time[stage] += now - time;
+					++run.stage_rows[stage];
+					run.end = now;
+				}
+			}
+#endif
+		}
+
+		if ( !filled ) {
+			if ( stage < GFMDS_STAGES ) {
+				gf_rows[i].quality = GFMDS_QUALITY_DEFERRED;
+				++*deferred_count;
+			} else {
+				++*no_gaps_filled_count;
+			}
+			continue;
+		}
+
+		/* compute quality */
+		gf_rows[i].quality =	(gf_rows[i].method > 0) +
+								((gf_rows[i].method == 1 && gf_rows[i].time_window > 14) || (gf_rows[i].method == 2 && gf_rows[i].time_window > 14) || (gf_rows[i].method == 3 && gf_rows[i].time_window > 1)) +
+								((gf_rows[i].method == 1 && gf_rows[i].time_window > 56) || (gf_rows[i].method == 2 && gf_rows[i].time_window > 28) || (gf_rows[i].method == 3 && gf_rows[i].time_window > 5));
+	}
+
+	/* last block */
+	if ( stream && (end_row > block_start) ) {
+		if ( stream->callback(gf_rows+block_start, block_start, end_row-block_start, stream->user_data) ) {
+			return GFMDS_ERR_STOPPED;
+		}
+	}
+
+#if defined (GF_STATS)
+	if ( tracer ) {
+		trace_run_flush(tracer, &run);
+	}
+	if ( stats ) {
+		stats->fill_time = get_wall_time() - fill_time;
+		stats->fill_cpu_time = get_cpu_time() - fill_cpu_time;
+	}
+#endif
+
+	/* ok */
+	return GFMDS_OK;
+}
+
+/* */
+static int is_timeres_valid(const GFMDS_PARAMS *const params) {
+	return (params->timeres >= GFMDS_QUATERHOURLY) && (params->timeres <= GFMDS_HOURLY);
+}
+
+/*
+	columns are not checked against struct_size, they can be beyond it
+	to read columnar data (see gfmds.h)
+*/
+static int are_params_valid(const GFMDS_PARAMS *const params, const int struct_size) {
+	if ( !is_timeres_valid(params) ) {
+		return 0;
+	}
+
+	if ( struct_size <= 0 ) {
+		return 0;
+	}
+
+	if (	(params->tofill_column < 0)
+			|| (params->driver1_column < 0)
+			|| (params->driver2a_column < 0)
+			|| (params->driver2b_column < 0) ) {
+		return 0;
+	}
+
+	/* qc columns can be -1 */
+	if (	(params->driver1_qc_column < -1)
+			|| (params->driver2a_qc_column < -1)
+			|| (params->driver2b_qc_column < -1) ) {
+		return 0;
+	}
+
+	return 1;
+}
+
+/* added on October 18, 2026: views over row structs, one per column of params */
+static void set_columns(GFMDS_COLUMN *const columns, const GFMDS_PARAMS *const params, const PREC *const values, const int struct_size) {
+	int i;
+	int index[GFMDS_COLUMNS];
+
+	assert(columns && params && values);
+
+	index[GFMDS_COLUMN_TOFILL] = params->tofill_column;
+	index[GFMDS_COLUMN_DRIVER1] = params->driver1_column;
+	index[GFMDS_COLUMN_DRIVER2A] = params->driver2a_column;
+	index[GFMDS_COLUMN_DRIVER2B] = params->driver2b_column;
+	index[GFMDS_COLUMN_DRIVER1_QC] = params->driver1_qc_column;
+	index[GFMDS_COLUMN_DRIVER2A_QC] = params->driver2a_qc_column;
+	index[GFMDS_COLUMN_DRIVER2B_QC] = params->driver2b_qc_column;
+
+	for ( i = 0; i < GFMDS_COLUMNS; i++ ) {
+		columns[i].values = (index[i] < 0) ? NULL : values+index[i];
+		columns[i].stride = struct_size;
+	}
+}
+
+/* */
+int gfmds_get_version(void) {
+	return GFMDS_VERSION;
+}
+
+/* */
+void gfmds_params_default(GFMDS_PARAMS *const params) {
+	assert(params);
+
+	params->timeres = GFMDS_HALFHOURLY;
+	params->driver1_tolerance_min = GF_DRIVER_1_TOLERANCE_MIN;
+	params->driver1_tolerance_max = GF_DRIVER_1_TOLERANCE_MAX;
+	params->driver2a_tolerance_min = GF_DRIVER_2A_TOLERANCE_MIN;
+	params->driver2a_tolerance_max = GF_DRIVER_2A_TOLERANCE_MAX;
+	params->driver2b_tolerance_min = GF_DRIVER_2B_TOLERANCE_MIN;
+	params->driver2b_tolerance_max = GF_DRIVER_2B_TOLERANCE_MAX;
+	params->tofill_column = 0;
+	params->driver1_column = 1;
+	params->driver2a_column = 2;
+	params->driver2b_column = 3;
+	params->driver1_qc_column = -1;
+	params->driver2a_qc_column = -1;
+	params->driver2b_qc_column = -1;
+	params->qc_thrs = INVALID_VALUE;
+	params->values_min = GF_ROWS_MIN;
+	params->compute_hat = 0;
+	params->start_row = -1;
+	params->end_row = -1;
+	params->work_budget = 0;
+}
+
+/* params can be NULL for defaults, returns NULL on error */
+GFMDS_CONTEXT *gfmds_create(const GFMDS_PARAMS *const params) {
+	GFMDS_CONTEXT *context;
+
+	context = malloc(sizeof*context);
+	if ( !context ) {
+		return NULL;
+	}
+	if ( params ) {
+		context->params = *params;
+	} else {
+		gfmds_params_default(&context->params);
+	}
+	context->stream.callback = NULL;
+	context->stream.user_data = NULL;
+	context->stream.block_rows = 0;
+	context->no_gaps_filled_count = 0;
+	context->deferred_count = 0;
+#if defined (GF_STATS)
+	memset(&context->stats, 0, sizeof context->stats);
+	context->tracer.callback = NULL;
+	context->tracer.user_data = NULL;
+#endif
+
+	return context;
+}
+
+/* */
+void gfmds_destroy(GFMDS_CONTEXT *context) {
+	free(context);
+}
+
+/* added on October 18, 2026: parameters of next gfmds_fill */
+void gfmds_set_params(GFMDS_CONTEXT *const context, const GFMDS_PARAMS *const params) {
+	assert(context && params);
+
+	context->params = *params;
+}
+
+/* added on October 18, 2026 */
+void gfmds_get_params(const GFMDS_CONTEXT *const context, GFMDS_PARAMS *const params) {
+	assert(context && params);
+
+	*params = context->params;
+}
+
+/*
+	added on October 18, 2026
+	callback of next fills, NULL to remove it. block_rows less than 1 are 1
+*/
+void gfmds_set_rows_callback(GFMDS_CONTEXT *const context, GFMDS_ROWS_CALLBACK callback, const int block_rows, void *const user_data) {
+	assert(context);
+
+	context->stream.callback = callback;
+	context->stream.user_data = user_data;
+	context->stream.block_rows = (block_rows < 1) ? 1 : block_rows;
+}
+
+/* */
+static int fill_values(GFMDS_CONTEXT *const context, const double *const values, const int struct_size, const int rows_count, GFMDS_ROW *const rows, const int refine) {
+	GFMDS_COLUMN columns[GFMDS_COLUMNS];
+
+	if ( !context || !values || !rows || (rows_count <= 0) || !are_params_valid(&context->params, struct_size) ) {
+		return GFMDS_ERR_PARAMS;
+	}
+
+	set_columns(columns, &context->params, values, struct_size);
+
+	return gf_mds_run(&context->params, columns, rows_count, rows, context->stream.callback ? &context->stream : NULL, refine, &context->no_gaps_filled_count, &context->deferred_count, CONTEXT_STATS(context), CONTEXT_TRACER(context));
+}
+
+/* */
+static int fill_columns(GFMDS_CONTEXT *const context, const GFMDS_COLUMN *const columns, const int rows_count, GFMDS_ROW *const rows, const int refine) {
+	int i;
+
+	if ( !context || !columns || !rows || (rows_count <= 0) || !is_timeres_valid(&context->params) ) {
+		return GFMDS_ERR_PARAMS;
+	}
+
+	/* qc columns can be NULL */
+	for ( i = 0; i < GFMDS_COLUMNS; i++ ) {
+		if ( (!columns[i].values && (i < GFMDS_COLUMN_DRIVER1_QC)) || (columns[i].stride <= 0) ) {
+			return GFMDS_ERR_PARAMS;
+		}
+	}
+
+	return gf_mds_run(&context->params, columns, rows_count, rows, context->stream.callback ? &context->stream : NULL, refine, &context->no_gaps_filled_count, &context->deferred_count, CONTEXT_STATS(context), CONTEXT_TRACER(context));
+}
+
+/* rows must hold rows_count rows, returns GFMDS_OK or an error */
+int gfmds_fill(GFMDS_CONTEXT *const context, const double *const values, const int struct_size, const int rows_count, GFMDS_ROW *const rows) {
+	return fill_values(context, values, struct_size, rows_count, rows, 0);
+}
+
+/*
+	added on October 18, 2026
+	columns is indexed by GFMDS_COLUMN_*, columns of context params are not used
+	rows must hold rows_count rows, returns GFMDS_OK or an error
+*/
+int gfmds_fill_columns(GFMDS_CONTEXT *const context, const GFMDS_COLUMN *const columns, const int rows_count, GFMDS_ROW *const rows) {
+	return fill_columns(context, columns, rows_count, rows, 0);
+}
+
+/*
+	added on October 18, 2026
+	fills rows deferred by a previous fill with the same values and params,
+	work_budget is not used
+*/
+int gfmds_refine(GFMDS_CONTEXT *const context, const double *const values, const int struct_size, const int rows_count, GFMDS_ROW *const rows) {
+	return fill_values(context, values, struct_size, rows_count, rows, 1);
+}
+
+/* added on October 18, 2026 */
+int gfmds_refine_columns(GFMDS_CONTEXT *const context, const GFMDS_COLUMN *const columns, const int rows_count, GFMDS_ROW *const rows) {
+	return fill_columns(context, columns, rows_count, rows, 1);
+}
+
+/* gaps that could not be filled by last gfmds_fill */
+int gfmds_get_no_gaps_filled_count(const GFMDS_CONTEXT *const context) {
+	assert(context);
+
+	return context->no_gaps_filled_count;
+}
+
+/* added on October 18, 2026: rows deferred by last fill, 0 after a refine */
+int gfmds_get_deferred_count(const GFMDS_CONTEXT *const context) {
+	assert(context);
+
+	return context->deferred_count;
+}
+
+/*
+	added on October 18, 2026
+	stats of last fill or refine, returns 0 (and zeroed stats) if the
+	engine is built without GF_STATS
+*/
+int gfmds_get_stats(const GFMDS_CONTEXT *const context, GFMDS_STATS *const stats) {
+	assert(context && stats);
+
+#if defined (GF_STATS)
+	*stats = context->stats;
+	return 1;
+#else
+	(void)context;
+	memset(stats, 0, sizeof*stats);
+	return 0;
+#endif
+}
+
+/*
+	added on October 18, 2026
+	callback of next fills, NULL to remove it. returns 0 if the engine
+	is built without GF_STATS (callback is never called)
+*/
+int gfmds_set_trace_callback(GFMDS_CONTEXT *const context, GFMDS_TRACE_CALLBACK callback, void *const user_data) {
+	assert(context);
+
+#if defined (GF_STATS)
+	context->tracer.callback = callback;
+	context->tracer.user_data = user_data;
+	return 1;
+#else
+	(void)context;
+	(void)callback;
+	(void)user_data;
+	return 0;
+#endif
+}
+
+/* */
+const char *gfmds_get_error_string(const int error) {
+	if ( (error < 0) || (error >= GFMDS_ERRORS) ) {
+		return "unknown error";
+	}
+
+	return error_strings[error];
+}
+
+/* updated on October 18, 2026: wrapper of gf_mds_run */
+GF_ROW *gf_mds_with_bounds(	PREC *values,
+							const int struct_size,
+							const int rows_count,
+							const int columns_count,
+							const int timeres,
+							PREC value1_tolerance_min,
+							PREC value1_tolerance_max,
+							PREC value2_tolerance_min,
+							PREC value2_tolerance_max,
+							PREC value3_tolerance_min,
+							PREC value3_tolerance_max,
+							const int tofill_column,
+							const int value1_column,
+							const int value2_column,
+							const int value3_column,
+							const int value1_qc_column,
+							const int value2_qc_column,
+							const int value3_qc_column,
+							const int qc_thrs,
+							const int values_min,
+							const int compute_hat,
+							int start_row,
+							int end_row,
+							int *no_gaps_filled_count) {
+	GF_ROW *gf_rows;
+	GFMDS_PARAMS params;
+	GFMDS_COLUMN columns[GFMDS_COLUMNS];
+	int deferred_count;
+
+	/* */
+	assert(values && rows_count && no_gaps_filled_count);
+	assert((tofill_column < columns_count) && (value1_column < columns_count)
+			&& (value2_column < columns_count) && (value3_column < columns_count));
+
+	/* */
+	params.timeres = timeres;
+	params.driver1_tolerance_min = value1_tolerance_min;
+	params.driver1_tolerance_max = value1_tolerance_max;
+	params.driver2a_tolerance_min = value2_tolerance_min;
+	params.driver2a_tolerance_max = value2_tolerance_max;
+	params.driver2b_tolerance_min = value3_tolerance_min;
+	params.driver2b_tolerance_max = value3_tolerance_max;
+	params.tofill_column = tofill_column;
+	params.driver1_column = value1_column;
+	params.driver2a_column = value2_column;
+	params.driver2b_column = value3_column;
+	params.driver1_qc_column = value1_qc_column;
+	params.driver2a_qc_column = value2_qc_column;
+	params.driver2b_qc_column = value3_qc_column;
+	params.qc_thrs = qc_thrs;
+	params.values_min = values_min;
+	params.compute_hat = compute_hat;
+	params.start_row = start_row;
+	params.end_row = end_row;
+	params.work_budget = 0;
+
+	/* allocate memory */
+	gf_rows = malloc(rows_count*sizeof*gf_rows);
+	if ( !gf_rows ) {
+		puts(err_out_of_memory_gf);
+		return NULL;
+	}
+
+	set_columns(columns, &params, values, struct_size);
+	if ( GFMDS_OK != gf_mds_run(&params, columns, rows_count, gf_rows, NULL, 0, no_gaps_filled_count, &deferred_count, NULL, NULL) ) {
+		puts(err_gf_too_less_values);
+		free(gf_rows);
+		return NULL;
+	}
+
+	/* ok */
+	return gf_rows;
+}
+
+/* */
+GF_ROW *gf_mds(PREC *values, const int struct_size, const int rows_count, const int columns_count, const int timeres,
+																									PREC value1_tolerance_min,
+																									PREC value1_tolerance_max,
+																									PREC value2_tolerance_min,
+																									PREC value2_tolerance_max,
+																									PREC value3_tolerance_min,
+																									PREC value3_tolerance_max,
+																									const int tofill_column,
+																									const int value1_column,
+																									const int value2_column,
+																									const int value3_column,
+																									const int values_min,
+																									const int compute_hat,
+																									int *no_gaps_filled_count) {
+	return gf_mds_with_bounds(	values,
+								struct_size,
+								rows_count,
+								columns_count,
+								timeres,
+								value1_tolerance_min,
+								value1_tolerance_max,
+								value2_tolerance_min,
+								value2_tolerance_max,
+								value3_tolerance_min,
+								value3_tolerance_max,
+								tofill_column,
+								value1_column,
+								value2_column,
+								value3_column,
+								-1,
+								-1,
+								-1,
+								INVALID_VALUE,
+								values_min,
+								compute_hat,
+								-1,
+								-1,
+								no_gaps_filled_count
+	);
+}
+
+/* */
+GF_ROW *gf_mds_with_qc(PREC *values, const int struct_size, const int rows_count, const int columns_count, const int timeres,
+																										PREC value1_tolerance_min,
+																										PREC value1_tolerance_max,
+																										PREC value2_tolerance_min,
+																										PREC value2_tolerance_max,
+																										PREC value3_tolerance_min,
+																										PREC value3_tolerance_max,
+																										const int tofill_column,
+																										const int value1_column,
+																										const int value2_column,
+																										const int value3_column,
+																										const int value1_qc_column,
+																										const int value2_qc_column,
+																										const int value3_qc_column,
+																										const int qc_thrs,
+																										const int values_min,
+																										const int compute_hat,
+																										int *no_gaps_filled_count) {
+	return gf_mds_with_bounds(	values,
+								struct_size,
+								rows_count,
+								columns_count,
+								timeres,
+								value1_tolerance_min,
+								value1_tolerance_max,
+								value2_tolerance_min,
+								value2_tolerance_max,
+								value3_tolerance_min,
+								value3_tolerance_max,
+								tofill_column,
+								value1_column,
+								value2_column,
+								value3_column,
+								value1_qc_column,
+								value2_qc_column,
+								value3_qc_column,
+								qc_thrs,
+								values_min,
+								compute_hat,
+								-1,
+								-1,
+								no_gaps_filled_count
+	);
+}
@@ -0,0 +1,333 @@
+/*
+	gfmds.h
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	public interface of the gapfilling engine, added on October 18, 2026
+
+	this header is self contained and is the only one needed to use
+	libgfmds (see Makefile). a GFMDS_CONTEXT holds the parameters of a run,
+	results are written to rows allocated by the caller and nothing is
+	shared between contexts, so different threads can fill different
+	datasets at the same time, each with its own context.
+
+	values are read from rows of struct_size bytes, the value of column c
+	at row r is ((double *)((char *)values + r*struct_size))[c].
+	missing values are GFMDS_INVALID_VALUE.
+	columns stored one after the other in a single block are read too,
+	with struct_size = sizeof(double) and column c at c*rows_count.
+
+	typical use:
+
+		GFMDS_PARAMS params;
+		GFMDS_CONTEXT *context;
+
+		gfmds_params_default(&params);
+		params.timeres = GFMDS_HALFHOURLY;
+		params.tofill_column = 0;
+		...
+		context = gfmds_create(&params);
+		error = gfmds_fill(context, values, sizeof(MY_ROW), rows_count, rows);
+		gfmds_destroy(context);
+*/
+
+#ifndef GFMDS_H
+#define GFMDS_H
+
+/* c++ handling */
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/* version */
+#define GFMDS_VERSION_MAJOR		1
+#define GFMDS_VERSION_MINOR		6
+#define GFMDS_VERSION_PATCH		0
+#define GFMDS_VERSION			((GFMDS_VERSION_MAJOR*10000)+(GFMDS_VERSION_MINOR*100)+GFMDS_VERSION_PATCH)
+
+/* exported symbols */
+#if defined (_WIN32) && defined (GFMDS_SHARED)
+	#ifdef GFMDS_BUILD
+		#define GFMDS_API __declspec(dllexport)
+	#else
+		#define GFMDS_API __declspec(dllimport)
+	#endif
+#elif defined (__GNUC__) && (__GNUC__ >= 4)
+	#define GFMDS_API __attribute__((visibility("default")))
+#else
+	#define GFMDS_API
+#endif
+
+/* constants */
+#define GFMDS_INVALID_VALUE		-9999
+
+/* quality of rows left for gfmds_refine when work_budget is spent */
+#define GFMDS_QUALITY_DEFERRED	4
+
+/* time resolutions, same values of timeres in common.h */
+enum {
+	GFMDS_QUATERHOURLY = 1,
+	GFMDS_HALFHOURLY,
+	GFMDS_HOURLY
+};
+
+/* flags of GFMDS_ROW mask, set for valid input values */
+enum {
+	GFMDS_TOFILL_VALID		= 1 << 0,
+	GFMDS_DRIVER1_VALID		= 1 << 1,
+	GFMDS_DRIVER2A_VALID	= 1 << 2,
+	GFMDS_DRIVER2B_VALID	= 1 << 3
+};
+
+/* errors */
+enum {
+	GFMDS_OK = 0,
+	GFMDS_ERR_PARAMS,				/* invalid parameters */
+	GFMDS_ERR_OUT_OF_MEMORY,
+	GFMDS_ERR_TOO_FEW_VALUES,		/* less than values_min valid values to fill */
+	GFMDS_ERR_STOPPED,				/* rows callback returned non zero */
+
+	GFMDS_ERRORS
+};
+
+/*
+	stages of the cascade tried on each gap, in order: all drivers on
+	7 to 14 days, driver1 on 7 days, tofill on 0 to 2 days (same hours),
+	all drivers on 21 to 77 days, driver1 on 14 to 77 days and tofill
+	on 3 days to the whole dataset
+*/
+#define GFMDS_STAGES			6
+
+/* columns for gfmds_fill_columns */
+enum {
+	GFMDS_COLUMN_TOFILL = 0,
+	GFMDS_COLUMN_DRIVER1,
+	GFMDS_COLUMN_DRIVER2A,
+	GFMDS_COLUMN_DRIVER2B,
+	GFMDS_COLUMN_DRIVER1_QC,
+	GFMDS_COLUMN_DRIVER2A_QC,
+	GFMDS_COLUMN_DRIVER2B_QC,
+
+	GFMDS_COLUMNS
+};
+
+/* structures */
+typedef struct GFMDS_CONTEXT GFMDS_CONTEXT;
+
+/*
+	parameters of a run, use gfmds_params_default to initialize them.
+	a tolerance set to GFMDS_INVALID_VALUE uses the default one.
+	qc columns are -1 if not used, start_row and end_row are -1 for
+	the whole dataset.
+	work_budget caps window rows compared by a fill (0 for no limit):
+	once spent, gaps not filled by the first three stages are not looked
+	up in wider windows and get GFMDS_QUALITY_DEFERRED
+*/
+typedef struct {
+	int timeres;
+	double driver1_tolerance_min;
+	double driver1_tolerance_max;
+	double driver2a_tolerance_min;
+	double driver2a_tolerance_max;
+	double driver2b_tolerance_min;
+	double driver2b_tolerance_max;
+	int tofill_column;
+	int driver1_column;
+	int driver2a_column;
+	int driver2b_column;
+	int driver1_qc_column;
+	int driver2a_qc_column;
+	int driver2b_qc_column;
+	int qc_thrs;
+	int values_min;
+	int compute_hat;
+	int start_row;
+	int end_row;
+	double work_budget;
+} GFMDS_PARAMS;
+
+/*
+	result of a row. filled is the original value where it was valid
+	(unless compute_hat is set), similiar is used as work area
+*/
+typedef struct {
+	char mask;
+	double similiar;
+	double stddev;
+	double filled;
+	int quality;
+	int time_window;
+	int samples_count;
+	int method;
+} GFMDS_ROW;
+
+/*
+	view over a column, value of row r is at (const char *)values + r * stride.
+	stride is in bytes so a column can be an array or a field of a struct.
+	values is NULL for unused qc columns
+*/
+typedef struct {
+	const double *values;
+	int stride;
+} GFMDS_COLUMN;
+
+/*
+	receiver of finished rows, first_row is the index of rows[0].
+	called in row order from the thread of the fill, results of the rows
+	(not similiar) are final. return non zero to stop the fill
+*/
+typedef int (*GFMDS_ROWS_CALLBACK)(const GFMDS_ROW *const rows, const int first_row, const int rows_count, void *const user_data);
+
+/*
+	stats of a fill, collected only if the engine is built with
+	GF_STATS (make STATS=1). times are in seconds, rows_scanned
+	are window rows compared and candidates the similar rows found
+*/
+typedef struct {
+	double fill_time;
+	double fill_cpu_time;
+	double masks_time;
+	double stage_time[GFMDS_STAGES];
+	double rows_scanned[GFMDS_STAGES];
+	double candidates[GFMDS_STAGES];
+	int rows_tried[GFMDS_STAGES];
+	int rows_filled[GFMDS_STAGES];
+} GFMDS_STATS;
+
+/*
+	consecutive rows gapfilled by a fill that are all gaps or all valid
+	values (compute_hat), passed to the trace callback when the run ends.
+	start and end are seconds of a monotonic clock, stage_time and
+	stage_rows add time and rows of each stage over the run.
+	available only with GF_STATS, like GFMDS_STATS
+*/
+typedef struct {
+	int first_row;
+	int rows_count;
+	int gaps;
+	double start;
+	double end;
+	double stage_time[GFMDS_STAGES];
+	int stage_rows[GFMDS_STAGES];
+} GFMDS_TRACE_RUN;
+
+typedef void (*GFMDS_TRACE_CALLBACK)(const GFMDS_TRACE_RUN *const run, void *const user_data);
+
+/* prototypes */
+GFMDS_API int gfmds_get_version(void);
+GFMDS_API void gfmds_params_default(GFMDS_PARAMS *const params);
+GFMDS_API GFMDS_CONTEXT *gfmds_create(const GFMDS_PARAMS *const params);
+GFMDS_API void gfmds_destroy(GFMDS_CONTEXT *context);
+GFMDS_API void gfmds_set_params(GFMDS_CONTEXT *const context, const GFMDS_PARAMS *const params);
+GFMDS_API void gfmds_get_params(const GFMDS_CONTEXT *const context, GFMDS_PARAMS *const params);
+GFMDS_API void gfmds_set_rows_callback(GFMDS_CONTEXT *const context, GFMDS_ROWS_CALLBACK callback, const int block_rows, void *const user_data);
+GFMDS_API int gfmds_fill(GFMDS_CONTEXT *const context, const double *const values, const int struct_size, const int rows_count, GFMDS_ROW *const rows);
+GFMDS_API int gfmds_fill_columns(GFMDS_CONTEXT *const context, const GFMDS_COLUMN *const columns, const int rows_count, GFMDS_ROW *const rows);
+GFMDS_API int gfmds_refine(GFMDS_CONTEXT *const context, const double *const values, const int struct_size, const int rows_count, GFMDS_ROW *const rows);
+GFMDS_API int gfmds_refine_columns(GFMDS_CONTEXT *const context, const GFMDS_COLUMN *const columns, const int rows_count, GFMDS_ROW *const rows);
+GFMDS_API int gfmds_get_no_gaps_filled_count(const GFMDS_CONTEXT *const context);
+GFMDS_API int gfmds_get_deferred_count(const GFMDS_CONTEXT *const context);
+GFMDS_API int gfmds_get_stats(const GFMDS_CONTEXT *const context, GFMDS_STATS *const stats);
+GFMDS_API int gfmds_set_trace_callback(GFMDS_CONTEXT *const context, GFMDS_TRACE_CALLBACK callback, void *const user_data);
+GFMDS_API const char *gfmds_get_error_string(const int error);
+
+/* previous interface, results are allocated with malloc and errors printed on stdout */
+GFMDS_API GFMDS_ROW *gf_mds(double *values,
+							const int struct_size,
+							const int rows_count,
+							const int columns_count,
+							const int timeres,
+							double value1_tolerance_min,
+							double value1_tolerance_max,
+							double value2_tolerance_min,
+							double value2_tolerance_max,
+							double value3_tolerance_min,
+							double value3_tolerance_max,
+							const int tofill_column,
+							const int value1_column,
+							const int value2_column,
+							const int value3_column,
+							const int values_min,
+							const int compute_hat,
+							int *no_gaps_filled_count
+);
+
+GFMDS_API GFMDS_ROW *gf_mds_with_qc(double *values,
+									const int struct_size,
+									const int rows_count,
+									const int columns_count,
+									const int timeres,
+									double value1_tolerance_min,
+									double value1_tolerance_max,
+									double value2_tolerance_min,
+									double value2_tolerance_max,
+									double value3_tolerance_min,
+									double value3_tolerance_max,
+									const int tofill_column,
+									const int value1_column,
+									const int value2_column,
+									const int value3_column,
+									const int value1_qc_column,
+									const int value2_qc_column,
+									const int value3_qc_column,
+									const int qc_thrs,
+									const int values_min,
+									const int compute_hat,
+									int *no_gaps_filled_count
+);
+
+GFMDS_API GFMDS_ROW *gf_mds_with_bounds(double *values,
+										const int struct_size,
+										const int rows_count,
+										const int columns_count,
+										const int timeres,
+										double value1_tolerance_min,
+										double value1_tolerance_max,
+										double value2_tolerance_min,
+										double value2_tolerance_max,
+										double value3_tolerance_min,
+										double value3_tolerance_max,
+										const int tofill_column,
+										const int value1_column,
+										const int value2_column,
+										const int value3_column,
+										const int value1_qc_column,
+										const int value2_qc_column,
+										const int value3_qc_column,
+										const int qc_thrs,
+										const int values_min,
+										const int compute_hat,
+										int start_row,
+										int end_row,
+										int *no_gaps_filled_count
+);
+GFMDS_API double gf_get_similiar_standard_deviation(const GFMDS_ROW *const gf_rows, const int rows_count);
+GFMDS_API double gf_get_similiar_median(const GFMDS_ROW *const gf_rows, const int rows_count, int *const error);
+
+/* c++ handling */
+#ifdef __cplusplus
+	}
+#endif
+
+#endif /* GFMDS_H */
@@ -0,0 +1,390 @@
+/*
+	gfmds.hpp
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	header only c++ interface of the gapfilling engine, added on October 18, 2026
+
+	requires c++20 (std::span) and the engine (src/gfmds.c or libgfmds).
+	column roles and time resolution are template parameters, so a wrong
+	layout is a compile error and records are read in place:
+
+		struct record { double nee, sw_in, ta, vpd; };
+
+		gfmds::engine<gfmds::timeres::halfhourly, gfmds::layout<0, 1, 2, 3>> engine;
+		gfmds::result rows = engine.fill(std::span<const record>(records), &arena);
+
+	columns stored one after the other in a single block are read with
+	gfmds::column_block, independent columns (each with its own stride)
+	with gfmds::columns. results are allocated from the given
+	std::pmr::memory_resource (the default one if omitted) or written to a
+	span of GFMDS_ROW owned by the caller.
+	an engine owns a GFMDS_CONTEXT, use one engine per thread.
+	errors are thrown as gfmds::error.
+*/
+
+#ifndef GFMDS_HPP
+#define GFMDS_HPP
+
+/* includes */
+#include <algorithm>
+#include <cstddef>
+#include <climits>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "gfmds.h"
+
+namespace gfmds {
+
+/* time resolutions */
+enum class timeres : int {
+	quaterhourly = GFMDS_QUATERHOURLY,
+	halfhourly = GFMDS_HALFHOURLY,
+	hourly = GFMDS_HOURLY
+};
+
+/* */
+class error : public std::runtime_error {
+public:
+	explicit error(const int code) : std::runtime_error(gfmds_get_error_string(code)), code_(code) { }
+	int code() const noexcept { return code_; }
+
+private:
+	int code_;
+};
+
+/*
+	column of each role, indexes of doubles inside a record (or of columns
+	inside a column_block). qc columns are -1 if not used
+*/
+template <int ToFill, int Driver1, int Driver2a, int Driver2b, int Driver1Qc = -1, int Driver2aQc = -1, int Driver2bQc = -1>
+struct layout {
+	static constexpr int tofill = ToFill;
+	static constexpr int driver1 = Driver1;
+	static constexpr int driver2a = Driver2a;
+	static constexpr int driver2b = Driver2b;
+	static constexpr int driver1_qc = Driver1Qc;
+	static constexpr int driver2a_qc = Driver2aQc;
+	static constexpr int driver2b_qc = Driver2bQc;
+
+	/* columns used, the highest index plus one */
+	static constexpr int columns_count = 1 + std::max({ ToFill, Driver1, Driver2a, Driver2b, Driver1Qc, Driver2aQc, Driver2bQc });
+
+	static_assert((ToFill >= 0) && (Driver1 >= 0) && (Driver2a >= 0) && (Driver2b >= 0), "columns must be positive");
+	static_assert((Driver1Qc >= -1) && (Driver2aQc >= -1) && (Driver2bQc >= -1), "qc columns must be positive or -1");
+	static_assert((ToFill != Driver1) && (ToFill != Driver2a) && (ToFill != Driver2b)
+					&& (Driver1 != Driver2a) && (Driver1 != Driver2b) && (Driver2a != Driver2b), "a column can have one role only");
+};
+
+/* columns one after the other, column c of row r is data[c*rows_count+r] */
+struct column_block {
+	const double *data;
+	std::size_t rows_count;
+};
+
+/*
+	added on October 18, 2026
+	view over a column, value of row r is at (const char *)data + r * stride.
+	stride is in bytes, so a column can be an array or a field of a struct
+*/
+struct column {
+	const double *data = nullptr;
+	std::size_t stride = sizeof(double);
+
+	column() = default;
+	column(const double *const d, const std::size_t s = sizeof(double)) noexcept : data(d), stride(s) { }
+	column(const std::span<const double> s) noexcept : data(s.data()) { }
+};
+
+/*
+	added on October 18, 2026
+	a column for each role, read in place. qc columns without data are not used,
+	the layout of the engine is not used
+*/
+struct columns {
+	column tofill;
+	column driver1;
+	column driver2a;
+	column driver2b;
+	column driver1_qc;
+	column driver2a_qc;
+	column driver2b_qc;
+	std::size_t rows_count = 0;
+};
+
+/* parameters that are not part of the layout, defaults of gfmds_params_default */
+struct settings {
+	double driver1_tolerance_min;
+	double driver1_tolerance_max;
+	double driver2a_tolerance_min;
+	double driver2a_tolerance_max;
+	double driver2b_tolerance_min;
+	double driver2b_tolerance_max;
+	int qc_thrs;
+	int values_min;
+	bool compute_hat;
+	int start_row;
+	int end_row;
+	double work_budget;
+
+	settings() {
+		GFMDS_PARAMS params;
+
+		gfmds_params_default(&params);
+		driver1_tolerance_min = params.driver1_tolerance_min;
+		driver1_tolerance_max = params.driver1_tolerance_max;
+		driver2a_tolerance_min = params.driver2a_tolerance_min;
+		driver2a_tolerance_max = params.driver2a_tolerance_max;
+		driver2b_tolerance_min = params.driver2b_tolerance_min;
+		driver2b_tolerance_max = params.driver2b_tolerance_max;
+		qc_thrs = params.qc_thrs;
+		values_min = params.values_min;
+		compute_hat = params.compute_hat != 0;
+		start_row = params.start_row;
+		end_row = params.end_row;
+		work_budget = params.work_budget;
+	}
+};
+
+/* rows allocated from a memory resource, released with it */
+class result {
+public:
+	result() noexcept : resource_(nullptr), rows_(nullptr), count_(0), no_gaps_filled_count_(0) { }
+
+	result(const std::size_t count, std::pmr::memory_resource *const resource)
+		: resource_(resource)
+		, rows_(static_cast<GFMDS_ROW *>(resource->allocate(count*sizeof(GFMDS_ROW), alignof(GFMDS_ROW))))
+		, count_(count)
+		, no_gaps_filled_count_(0) {
+	}
+
+	result(result &&other) noexcept
+		: resource_(std::exchange(other.resource_, nullptr))
+		, rows_(std::exchange(other.rows_, nullptr))
+		, count_(std::exchange(other.count_, 0))
+		, no_gaps_filled_count_(other.no_gaps_filled_count_) {
+	}
+
+	result &operator=(result &&other) noexcept {
+		if ( this != &other ) {
+			release();
+			resource_ = std::exchange(other.resource_, nullptr);
+			rows_ = std::exchange(other.rows_, nullptr);
+			count_ = std::exchange(other.count_, 0);
+			no_gaps_filled_count_ = other.no_gaps_filled_count_;
+		}
+		return *this;
+	}
+
+	result(const result &) = delete;
+	result &operator=(const result &) = delete;
+
+	~result() { release(); }
+
+	std::span<GFMDS_ROW> rows() noexcept { return std::span<GFMDS_ROW>(rows_, count_); }
+	std::span<const GFMDS_ROW> rows() const noexcept { return std::span<const GFMDS_ROW>(rows_, count_); }
+	const GFMDS_ROW &operator[](const std::size_t i) const noexcept { return rows_[i]; }
+	const GFMDS_ROW *begin() const noexcept { return rows_; }
+	const GFMDS_ROW *end() const noexcept { return rows_ + count_; }
+	std::size_t size() const noexcept { return count_; }
+	int no_gaps_filled_count() const noexcept { return no_gaps_filled_count_; }
+	void set_no_gaps_filled_count(const int count) noexcept { no_gaps_filled_count_ = count; }
+
+private:
+	void release() noexcept {
+		if ( rows_ ) {
+			resource_->deallocate(rows_, count_*sizeof(GFMDS_ROW), alignof(GFMDS_ROW));
+		}
+	}
+
+	std::pmr::memory_resource *resource_;
+	GFMDS_ROW *rows_;
+	std::size_t count_;
+	int no_gaps_filled_count_;
+};
+
+/* */
+template <timeres Timeres, typename Layout>
+class engine {
+public:
+	explicit engine(const settings &s = settings()) : context_(nullptr) {
+		GFMDS_PARAMS params;
+
+		gfmds_params_default(&params);
+		params.timeres = static_cast<int>(Timeres);
+		params.driver1_tolerance_min = s.driver1_tolerance_min;
+		params.driver1_tolerance_max = s.driver1_tolerance_max;
+		params.driver2a_tolerance_min = s.driver2a_tolerance_min;
+		params.driver2a_tolerance_max = s.driver2a_tolerance_max;
+		params.driver2b_tolerance_min = s.driver2b_tolerance_min;
+		params.driver2b_tolerance_max = s.driver2b_tolerance_max;
+		params.qc_thrs = s.qc_thrs;
+		params.values_min = s.values_min;
+		params.compute_hat = s.compute_hat;
+		params.start_row = s.start_row;
+		params.end_row = s.end_row;
+		params.work_budget = s.work_budget;
+		params.tofill_column = Layout::tofill;
+		params.driver1_column = Layout::driver1;
+		params.driver2a_column = Layout::driver2a;
+		params.driver2b_column = Layout::driver2b;
+		params.driver1_qc_column = Layout::driver1_qc;
+		params.driver2a_qc_column = Layout::driver2a_qc;
+		params.driver2b_qc_column = Layout::driver2b_qc;
+		context_ = gfmds_create(&params);
+		if ( !context_ ) {
+			throw std::bad_alloc();
+		}
+	}
+
+	engine(const engine &) = delete;
+	engine &operator=(const engine &) = delete;
+
+	~engine() { gfmds_destroy(context_); }
+
+	/* records read in place, Record is a struct of doubles */
+	template <typename Record>
+	int fill(const std::span<const Record> records, const std::span<GFMDS_ROW> rows) {
+		static_assert(std::is_standard_layout_v<Record> && std::is_trivially_copyable_v<Record>, "records must be plain structs");
+		static_assert(sizeof(Record) % sizeof(double) == 0, "records must be made of doubles");
+		static_assert(Layout::columns_count*sizeof(double) <= sizeof(Record), "layout columns are beyond the record");
+
+		if ( (rows.size() < records.size()) || (records.size() > INT_MAX) ) {
+			throw error(GFMDS_ERR_PARAMS);
+		}
+		return check(gfmds_fill(context_, reinterpret_cast<const double *>(records.data()), sizeof(Record), static_cast<int>(records.size()), rows.data()));
+	}
+
+	/* added on October 18, 2026: fills rows deferred by a fill of the same records */
+	template <typename Record>
+	int refine(const std::span<const Record> records, const std::span<GFMDS_ROW> rows) {
+		static_assert(std::is_standard_layout_v<Record> && std::is_trivially_copyable_v<Record>, "records must be plain structs");
+		static_assert(sizeof(Record) % sizeof(double) == 0, "records must be made of doubles");
+		static_assert(Layout::columns_count*sizeof(double) <= sizeof(Record), "layout columns are beyond the record");
+
+		if ( (rows.size() < records.size()) || (records.size() > INT_MAX) ) {
+			throw error(GFMDS_ERR_PARAMS);
+		}
+		return check(gfmds_refine(context_, reinterpret_cast<const double *>(records.data()), sizeof(Record), static_cast<int>(records.size()), rows.data()));
+	}
+
+	/* */
+	template <typename Record>
+	result fill(const std::span<const Record> records, std::pmr::memory_resource *const arena = std::pmr::get_default_resource()) {
+		result r(records.size(), arena);
+
+		r.set_no_gaps_filled_count(fill(records, r.rows()));
+		return r;
+	}
+
+	/* */
+	int fill(const column_block &block, const std::span<GFMDS_ROW> rows) {
+		columns c;
+
+		c.tofill = block.data + Layout::tofill*block.rows_count;
+		c.driver1 = block.data + Layout::driver1*block.rows_count;
+		c.driver2a = block.data + Layout::driver2a*block.rows_count;
+		c.driver2b = block.data + Layout::driver2b*block.rows_count;
+		if ( Layout::driver1_qc >= 0 ) {
+			c.driver1_qc = block.data + Layout::driver1_qc*block.rows_count;
+		}
+		if ( Layout::driver2a_qc >= 0 ) {
+			c.driver2a_qc = block.data + Layout::driver2a_qc*block.rows_count;
+		}
+		if ( Layout::driver2b_qc >= 0 ) {
+			c.driver2b_qc = block.data + Layout::driver2b_qc*block.rows_count;
+		}
+		c.rows_count = block.rows_count;
+		return fill(c, rows);
+	}
+
+	/* */
+	result fill(const column_block &block, std::pmr::memory_resource *const arena = std::pmr::get_default_resource()) {
+		result r(block.rows_count, arena);
+
+		r.set_no_gaps_filled_count(fill(block, r.rows()));
+		return r;
+	}
+
+	/* added on October 18, 2026 */
+	int fill(const columns &c, const std::span<GFMDS_ROW> rows) {
+		return run(c, rows, gfmds_fill_columns);
+	}
+
+	/* added on October 18, 2026 */
+	int refine(const columns &c, const std::span<GFMDS_ROW> rows) {
+		return run(c, rows, gfmds_refine_columns);
+	}
+
+	/* */
+	result fill(const columns &c, std::pmr::memory_resource *const arena = std::pmr::get_default_resource()) {
+		result r(c.rows_count, arena);
+
+		r.set_no_gaps_filled_count(fill(c, r.rows()));
+		return r;
+	}
+
+	/* added on October 18, 2026: rows deferred by last fill */
+	int deferred_count() const noexcept { return gfmds_get_deferred_count(context_); }
+
+private:
+	/* */
+	int run(const columns &c, const std::span<GFMDS_ROW> rows, int (*const f)(GFMDS_CONTEXT *const, const GFMDS_COLUMN *const, const int, GFMDS_ROW *const)) {
+		const column *const views[GFMDS_COLUMNS] = { &c.tofill, &c.driver1, &c.driver2a, &c.driver2b, &c.driver1_qc, &c.driver2a_qc, &c.driver2b_qc };
+		GFMDS_COLUMN v[GFMDS_COLUMNS];
+
+		if ( (rows.size() < c.rows_count) || (c.rows_count > INT_MAX) ) {
+			throw error(GFMDS_ERR_PARAMS);
+		}
+		for ( int i = 0; i < GFMDS_COLUMNS; i++ ) {
+			if ( views[i]->stride > INT_MAX ) {
+				throw error(GFMDS_ERR_PARAMS);
+			}
+			v[i].values = views[i]->data;
+			v[i].stride = static_cast<int>(views[i]->stride);
+		}
+		return check(f(context_, v, static_cast<int>(c.rows_count), rows.data()));
+	}
+
+	/* returns gaps not filled */
+	int check(const int e) {
+		if ( GFMDS_OK != e ) {
+			if ( GFMDS_ERR_OUT_OF_MEMORY == e ) {
+				throw std::bad_alloc();
+			}
+			throw error(e);
+		}
+		return gfmds_get_no_gaps_filled_count(context_);
+	}
+
+	GFMDS_CONTEXT *context_;
+};
+
+} /* namespace gfmds */
+
+#endif /* GFMDS_HPP */
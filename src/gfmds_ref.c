@@ -0,0 +1,656 @@
+/*
+	gfmds_ref.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	reference gapfilling engine, added on October 18, 2026
+
+	this is gf_mds_with_bounds as it was validated against the original
+	implementation, before the engine was moved to gfmds.c and optimized.
+	it is kept frozen so -verify can compare the engine against it:
+	do not change it, only gfmds.c has to become faster
+*/
+
+/* includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "common.h"
+#include "gfmds_ref.h"
+
+/* */
+extern const char err_out_of_memory[];
+static const char err_gf_too_less_values[] = "too few valid values to apply gapfilling\n";
+
+/* private function for gapfilling */
+static PREC ref_get_similiar_mean(const GF_ROW *const gf_rows, const int rows_count) {
+ 	int i;
+	PREC mean;
+
+	/* check parameter */
+	assert(gf_rows);
+
+	/* get mean */
+	mean = 0.0;
+	for ( i = 0; i < rows_count; i++ ) {
+		mean += gf_rows[i].similiar;
+	}
+	mean /= rows_count;
+
+	/* check for NAN */
+	if ( mean != mean ) {
+		mean = INVALID_VALUE;
+	}
+
+	/* */
+	return mean;
+}
+
+/* gapfilling */
+static PREC ref_get_similiar_standard_deviation(const GF_ROW *const gf_rows, const int rows_count) {
+	int i;
+	PREC mean;
+	PREC sum;
+	PREC sum2;
+
+	/* check parameter */
+	assert(gf_rows);
+
+	/* get mean */
+	mean = ref_get_similiar_mean(gf_rows, rows_count);
+	if ( IS_INVALID_VALUE(mean) ) {
+		return INVALID_VALUE;
+	}
+
+	/* compute standard deviation */
+	sum = 0.0;
+	sum2 = 0.0;
+	for ( i = 0; i < rows_count; i++ ) {
+		sum = (gf_rows[i].similiar - mean);
+		sum *= sum;
+		sum2 += sum;
+	}
+	sum2 /= rows_count-1;
+	sum2 = (PREC)SQRT(sum2);
+
+	/* check for NAN */
+	if ( sum2 != sum2 ) {
+		sum2 = INVALID_VALUE;
+	}
+
+	/* */
+	return sum2;
+}
+
+/* private function for gapfilling */
+static int ref_gapfill(	PREC *values,
+						const int struct_size,
+						GF_ROW *const gf_rows,
+						const int start_window,
+						const int end_window,
+						const int current_row,
+						const int start,
+						const int end,
+						const int step,
+						const int method,
+						const int timeres,
+						const PREC value1_tolerance_min,
+						const PREC value1_tolerance_max,
+						const PREC value2_tolerance_min,
+						const PREC value2_tolerance_max,
+						const PREC value3_tolerance_min,
+						const PREC value3_tolerance_max,
+						const int tofill_column,
+						const int value1_column,
+						const int value2_column,
+						const int value3_column) {
+	int i;
+	int y;
+	int j;
+	int z;
+	int window;
+	int window_start;
+	int window_end;
+	int window_current;
+	int samples_count;
+	PREC value1_tolerance;
+	PREC value2_tolerance;
+	PREC value3_tolerance;
+	PREC *window_current_values;
+	PREC *row_current_values;
+
+	/* check parameter */
+	assert(values && gf_rows && (method >=0 && method < GF_METHODS));
+	assert((timeres > SPOT_TIMERES) && (timeres <= HOURLY_TIMERES));
+
+	/* reset */
+	window = 0;
+	window_start = 0;
+	window_end = 0;
+	window_current = 0;
+	samples_count = 0;
+	value1_tolerance = value1_tolerance_min;
+	value2_tolerance = value2_tolerance_min;
+	value3_tolerance = value3_tolerance_min;
+
+	/* modified on January 17, 2018 */
+	/* j is and index checker for timeres */
+	switch ( timeres ) {
+		case QUATERHOURLY_TIMERES:
+			j = 9;
+		break;
+
+		case HALFHOURLY_TIMERES:
+			j = 5;
+		break;
+
+		case HOURLY_TIMERES:
+			j = 3;
+		break;
+	}
+
+	/* */
+	i = start;
+	if ( GF_TOFILL_METHOD == method ) {
+		/* modified on January 17, 2018 */
+		switch ( timeres ) {
+			case QUATERHOURLY_TIMERES:
+				z = 96;
+			break;
+
+			case HALFHOURLY_TIMERES:
+				z = 48;
+			break;
+
+			case HOURLY_TIMERES:
+				z = 24;
+			break;
+		}
+	} else {
+		z = 1;
+	}
+	while ( i <= end ) {
+		/* reset */
+		samples_count = 0;
+
+		/* compute window */
+		/* modified on January 17, 2018 */
+		switch ( timeres ) {
+			case QUATERHOURLY_TIMERES:
+				window = 96 * i;
+			break;
+
+			case HALFHOURLY_TIMERES:
+				window = 48 * i;
+			break;
+
+			case HOURLY_TIMERES:
+				window = 24 * i;
+			break;
+		}
+
+		/* get window start index */
+		window_start = current_row - window;
+		if ( GF_TOFILL_METHOD == method ) {
+			/* modified on January 17, 2018 */
+			switch ( timeres ) {
+				case QUATERHOURLY_TIMERES:
+					window_start -= 4;
+				break;
+
+				case HALFHOURLY_TIMERES:
+					window_start -= 2;
+				break;
+
+				case HOURLY_TIMERES:
+					window_start -= 1;
+				break;
+			}
+		}
+
+		if ( GF_TOFILL_METHOD != method ) {
+			/* fix for recreate markus code */
+			++window_start;
+		}
+
+		/* get window end index */
+		window_end = current_row + window;
+		if (GF_TOFILL_METHOD == method ) {
+			/* modified on January 17, 2018 */
+			switch ( timeres ) {
+				case QUATERHOURLY_TIMERES:
+					window_end += 5;
+				break;
+
+				case HALFHOURLY_TIMERES:
+					window_end += 3;
+				break;
+
+				case HOURLY_TIMERES:
+					window_end += 2;
+				break;
+			}
+		}
+
+		/*	fix bounds for first two methods
+			cause in hour method (NEE_METHOD) a window start at -32 and window end at 69,
+			it will be fixed to window start at 0 and this is an error...
+		*/
+		if ( GF_TOFILL_METHOD != method ) {
+			if ( window_start < 0 ) {
+				window_start = 0;
+			}
+
+			if ( window_end > end_window ) {
+				window_end = end_window;
+			}
+
+			/* modified on June 25, 2013 */
+			/* compute tolerance for value1 */
+			if ( IS_INVALID_VALUE(value1_tolerance_min) ) {
+				value1_tolerance = value1_tolerance_max;
+			} else if ( IS_INVALID_VALUE(value1_tolerance_max) ) {
+				value1_tolerance = value1_tolerance_min;
+			} else {
+				value1_tolerance = ((PREC *)(((char *)values)+current_row*struct_size))[value1_column];
+				if ( value1_tolerance < value1_tolerance_min ) {
+					value1_tolerance = value1_tolerance_min;
+				} else if ( value1_tolerance > value1_tolerance_max ) {
+					value1_tolerance = value1_tolerance_max;
+				}
+			}
+
+			/* modified on January 17, 2018 */
+			/* compute tolerance for value2 */
+			if ( IS_INVALID_VALUE(value2_tolerance_min) ) {
+				value2_tolerance = GF_DRIVER_2A_TOLERANCE_MIN;
+			} else if ( ! IS_INVALID_VALUE(value2_tolerance_max) ) {
+				value2_tolerance = ((PREC *)(((char *)values)+current_row*struct_size))[value2_column];
+				if ( value2_tolerance < value2_tolerance_min ) {
+					value2_tolerance = value2_tolerance_min;
+				} else if ( value2_tolerance > value2_tolerance_max ) {
+					value2_tolerance = value2_tolerance_max;
+				}
+			}
+
+			/* modified on January 17, 2018 */
+			/* compute tolerance for value3 */
+			if ( IS_INVALID_VALUE(value3_tolerance_min) ) {
+				value3_tolerance = GF_DRIVER_2B_TOLERANCE_MIN;
+			} else if ( ! IS_INVALID_VALUE(value3_tolerance_max) ) {
+				value3_tolerance = ((PREC *)(((char *)values)+current_row*struct_size))[value3_column];
+				if ( value3_tolerance < value3_tolerance_min ) {
+					value3_tolerance = value3_tolerance_min;
+				} else if ( value3_tolerance > value3_tolerance_max ) {
+					value3_tolerance = value3_tolerance_max;
+				}
+			}
+		}
+
+		assert(! IS_INVALID_VALUE(value1_tolerance));
+		assert(! IS_INVALID_VALUE(value2_tolerance));
+		assert(! IS_INVALID_VALUE(value3_tolerance));
+
+		/* loop through window */
+		for ( window_current = window_start; window_current < window_end; window_current += z ) {
+			window_current_values = ((PREC *)(((char *)values)+window_current*struct_size));
+			row_current_values = ((PREC *)(((char *)values)+current_row*struct_size));
+
+			switch ( method ) {
+				case GF_ALL_METHOD:
+					if ( IS_FLAG_SET(gf_rows[window_current].mask, GF_ALL_VALID) ) {
+						if (
+								(FABS(window_current_values[value2_column]-row_current_values[value2_column]) < value2_tolerance) &&
+								(FABS(window_current_values[value1_column]-row_current_values[value1_column]) < value1_tolerance) &&
+								(FABS(window_current_values[value3_column]-row_current_values[value3_column]) < value3_tolerance)
+							) {
+							gf_rows[samples_count++].similiar = window_current_values[tofill_column];
+						}
+					}
+				break;
+
+				case GF_VALUE1_METHOD:
+					if ( IS_FLAG_SET(gf_rows[window_current].mask, (GF_TOFILL_VALID|GF_VALUE1_VALID)) ) {
+						if ( FABS(window_current_values[value1_column]-row_current_values[value1_column]) < value1_tolerance ) {
+							gf_rows[samples_count++].similiar = window_current_values[tofill_column];
+						}
+					}
+				break;
+
+				case GF_TOFILL_METHOD:
+					for ( y = 0; y < j; y++ ) {
+						if ( ((window_current+y) < 0) || (window_current+y) >= end_window ) {
+							continue;
+						}
+						if ( IS_FLAG_SET(gf_rows[window_current+y].mask, GF_TOFILL_VALID) ) {
+							gf_rows[samples_count++].similiar = ((PREC *)(((char *)values)+((window_current+y)*struct_size)))[tofill_column];
+						}
+					}
+				break;
+			}
+		}
+
+		if ( samples_count > 1 ) {
+			/* set mean */
+			gf_rows[current_row].filled = ref_get_similiar_mean(gf_rows, samples_count);
+
+			/* set standard deviation */
+			gf_rows[current_row].stddev = ref_get_similiar_standard_deviation(gf_rows, samples_count);
+
+			/* set method */
+			gf_rows[current_row].method = method + 1;
+
+			/* set time-window */
+			gf_rows[current_row].time_window = i * 2;
+
+			/* fix hour method timewindow */
+			if ( GF_TOFILL_METHOD == method ) {
+				++gf_rows[current_row].time_window;
+			}
+
+			/* set samples */
+			gf_rows[current_row].samples_count = samples_count;
+
+			/* ok */
+			return 1;
+		}
+
+		/* inc loop */
+		i += step;
+
+		/* break if window bigger than  */
+		if ( (window_start < start_window) && (window_end > end_window) ) {
+			break;
+		}
+	}
+
+	/* */
+	return 0;
+}
+
+/*
+	same parameters and results of gf_mds_with_bounds, returned rows
+	must be freed by the caller
+*/
+GF_ROW *gf_mds_ref(			PREC *values,
+							const int struct_size,
+							const int rows_count,
+							const int columns_count,
+							const int timeres,
+							PREC value1_tolerance_min,
+							PREC value1_tolerance_max,
+							PREC value2_tolerance_min,
+							PREC value2_tolerance_max,
+							PREC value3_tolerance_min,
+							PREC value3_tolerance_max,
+							const int tofill_column,
+							const int value1_column,
+							const int value2_column,
+							const int value3_column,
+							const int value1_qc_column,
+							const int value2_qc_column,
+							const int value3_qc_column,
+							const int qc_thrs,
+							const int values_min,
+							const int compute_hat,
+							int start_row,
+							int end_row,
+							int *no_gaps_filled_count) {
+	int i;
+	int c;
+	int valids_count;
+	GF_ROW *gf_rows;
+
+	/* */
+	assert(values && rows_count && no_gaps_filled_count);
+
+	/* reset */
+	*no_gaps_filled_count = 0;
+	if ( start_row < 0  ) {
+		start_row = 0;
+	}
+	if ( -1 == end_row ) {
+		end_row = rows_count;
+	} else if ( end_row > rows_count ) {
+		end_row = rows_count;
+	}
+
+	/* allocate memory */
+	gf_rows = malloc(rows_count*sizeof*gf_rows);
+	if ( !gf_rows ) {
+		puts(err_out_of_memory);
+		return NULL;
+	}
+
+	/* reset */
+	for ( i = 0; i < rows_count; i++ ) {
+		gf_rows[i].mask = 0;
+		gf_rows[i].similiar = INVALID_VALUE;
+		gf_rows[i].stddev = INVALID_VALUE;
+		gf_rows[i].filled = INVALID_VALUE;
+		gf_rows[i].quality = INVALID_VALUE;
+		gf_rows[i].time_window = 0;
+		gf_rows[i].samples_count = 0;
+		gf_rows[i].method = 0;
+	}
+
+	/* update mask and count valids TO FILL */
+	valids_count = 0;
+	for ( i = start_row; i < end_row; i++ ) {
+		for ( c = 0; c < columns_count; c++ ) {
+			if ( !IS_INVALID_VALUE(((PREC *)(((char *)values)+i*struct_size))[c]) ) {
+				if ( tofill_column == c ) {
+					gf_rows[i].mask |= GF_TOFILL_VALID;
+				} else if ( value1_column == c ) {
+					gf_rows[i].mask |= GF_VALUE1_VALID;
+				} else if ( value2_column == c ) {
+					gf_rows[i].mask |= GF_VALUE2_VALID;
+				} else if ( value3_column == c ) {
+					gf_rows[i].mask |= GF_VALUE3_VALID;
+				}
+			}
+		}
+
+		/* check for QC */
+		if (	!IS_INVALID_VALUE(qc_thrs) &&
+				(value1_qc_column != -1) &&
+				!IS_INVALID_VALUE(((PREC *)(((char *)values)+i*struct_size))[value1_qc_column]) ) {
+			if ( ((PREC *)(((char *)values)+i*struct_size))[value1_qc_column] > qc_thrs ) {
+				gf_rows[i].mask &= ~GF_VALUE1_VALID;
+			}
+		}
+
+		if (	!IS_INVALID_VALUE(qc_thrs) &&
+				(value2_qc_column != -1) &&
+				!IS_INVALID_VALUE(((PREC *)(((char *)values)+i*struct_size))[value2_qc_column]) ) {
+			if ( ((PREC *)(((char *)values)+i*struct_size))[value2_qc_column] > qc_thrs ) {
+				gf_rows[i].mask &= ~GF_VALUE2_VALID;
+			}
+		}
+
+		if (	!IS_INVALID_VALUE(qc_thrs) &&
+				(value3_qc_column != -1) &&
+				!IS_INVALID_VALUE(((PREC *)(((char *)values)+i*struct_size))[value3_qc_column]) ) {
+			if ( ((PREC *)(((char *)values)+i*struct_size))[value3_qc_column] > qc_thrs ) {
+				gf_rows[i].mask &= ~GF_VALUE3_VALID;
+			}
+		}
+
+		if ( IS_FLAG_SET(gf_rows[i].mask, GF_TOFILL_VALID) ) {
+			++valids_count;
+		}
+	}
+
+	if ( valids_count < values_min ) {
+		puts(err_gf_too_less_values);
+		free(gf_rows);
+		return NULL;
+	}
+
+	/* modified on January 17, 2018 */
+	if ( IS_INVALID_VALUE(value1_tolerance_min) && IS_INVALID_VALUE(value1_tolerance_max) ) {
+		value1_tolerance_min = GF_DRIVER_1_TOLERANCE_MIN;
+		value1_tolerance_max = GF_DRIVER_1_TOLERANCE_MAX;
+	} else if ( IS_INVALID_VALUE(value1_tolerance_min) ) {
+		value1_tolerance_min = GF_DRIVER_1_TOLERANCE_MIN;
+	} else if ( IS_INVALID_VALUE(value1_tolerance_max) ) {
+		value1_tolerance_max = INVALID_VALUE;
+	}
+
+	/* modified on January 17, 2018 */
+	if ( IS_INVALID_VALUE(value2_tolerance_min) && IS_INVALID_VALUE(value2_tolerance_max) ) {
+		value2_tolerance_min = GF_DRIVER_2A_TOLERANCE_MIN;
+		value2_tolerance_max = GF_DRIVER_2A_TOLERANCE_MAX;
+	} else if ( IS_INVALID_VALUE(value2_tolerance_min) ) {
+		value2_tolerance_min = GF_DRIVER_2A_TOLERANCE_MIN;
+	} else if ( IS_INVALID_VALUE(value2_tolerance_max) ) {
+		value2_tolerance_max = INVALID_VALUE;
+	}
+
+	/* modified on January 17, 2018 */
+	if ( IS_INVALID_VALUE(value3_tolerance_min) && IS_INVALID_VALUE(value3_tolerance_max) ) {
+		value3_tolerance_min = GF_DRIVER_2B_TOLERANCE_MIN;
+		value3_tolerance_max = GF_DRIVER_2B_TOLERANCE_MAX;
+	} else if ( IS_INVALID_VALUE(value3_tolerance_min) ) {
+		value3_tolerance_min = GF_DRIVER_2B_TOLERANCE_MIN;
+	} else if ( IS_INVALID_VALUE(value3_tolerance_max) ) {
+		value3_tolerance_max = INVALID_VALUE;
+	}
+
+	/* loop for each row */
+	for ( i = start_row; i < end_row; i++ ) {
+		/* copy value from TOFILL to FILLED */
+		gf_rows[i].filled = ((PREC *)(((char *)values)+i*struct_size))[tofill_column];
+
+		/* compute hat ? */
+		if ( !IS_INVALID_VALUE(gf_rows[i].filled) && !compute_hat ) {
+			continue;
+		}
+
+		/*	fill
+			Added 20140422: if a gap is impossible to fill, e.g. if with MDV there are no data in the whole dataset acquired in a range +/- one hour,
+			the data point is not filled and the qc is set to -9999
+		*/
+		if ( !ref_gapfill(values, struct_size, gf_rows, start_row, end_row, i, 7, 14, 7, GF_ALL_METHOD, timeres, value1_tolerance_min, value1_tolerance_max, value2_tolerance_min, value2_tolerance_max, value3_tolerance_min, value3_tolerance_max, tofill_column, value1_column, value2_column, value3_column) )
+			if ( !ref_gapfill(values, struct_size, gf_rows, start_row, end_row, i, 7, 7, 7, GF_VALUE1_METHOD, timeres, value1_tolerance_min, value1_tolerance_max, value2_tolerance_min, value2_tolerance_max, value3_tolerance_min, value3_tolerance_max, tofill_column, value1_column, value2_column, value3_column) )
+				if ( !ref_gapfill(values, struct_size, gf_rows, start_row, end_row, i, 0, 2, 1, GF_TOFILL_METHOD, timeres, value1_tolerance_min, value1_tolerance_max, value2_tolerance_min, value2_tolerance_max, value3_tolerance_min, value3_tolerance_max, tofill_column, value1_column, value2_column, value3_column) )
+					if ( !ref_gapfill(values, struct_size, gf_rows, start_row, end_row, i, 21, 77, 7, GF_ALL_METHOD, timeres, value1_tolerance_min, value1_tolerance_max, value2_tolerance_min, value2_tolerance_max, value3_tolerance_min, value3_tolerance_max, tofill_column, value1_column, value2_column, value3_column) )
+						if ( !ref_gapfill(values, struct_size, gf_rows, start_row, end_row, i, 14, 77, 7, GF_VALUE1_METHOD, timeres, value1_tolerance_min, value1_tolerance_max, value2_tolerance_min, value2_tolerance_max, value3_tolerance_min, value3_tolerance_max, tofill_column, value1_column, value2_column, value3_column) )
+							if ( !ref_gapfill(values, struct_size, gf_rows, start_row, end_row, i, 3, end_row + 1, 3, GF_TOFILL_METHOD, timeres, value1_tolerance_min, value1_tolerance_max, value2_tolerance_min, value2_tolerance_max, value3_tolerance_min, value3_tolerance_max, tofill_column, value1_column, value2_column, value3_column) ) {
+								++*no_gaps_filled_count;
+								continue;
+							}
+
+		/* compute quality */
+		gf_rows[i].quality =	(gf_rows[i].method > 0) +
+								((gf_rows[i].method == 1 && gf_rows[i].time_window > 14) || (gf_rows[i].method == 2 && gf_rows[i].time_window > 14) || (gf_rows[i].method == 3 && gf_rows[i].time_window > 1)) +
+								((gf_rows[i].method == 1 && gf_rows[i].time_window > 56) || (gf_rows[i].method == 2 && gf_rows[i].time_window > 28) || (gf_rows[i].method == 3 && gf_rows[i].time_window > 5));
+	}
+
+	/* ok */
+	return gf_rows;
+}
+
+/* names of output columns, added on October 18, 2026 */
+const char *gf_ref_get_field_name(const int field) {
+	static const char *const names[GF_REF_FIELDS] = { "FILLED", "STDDEV", "SAMPLE", "METHOD", "TIMEWINDOW", "QC" };
+
+	assert((field >= 0) && (field < GF_REF_FIELDS));
+	return names[field];
+}
+
+/*
+	added on October 18, 2026
+
+	values are equal if both are invalid or if they differ by no more
+	than tolerance times the biggest of 1 and the reference, so a
+	tolerance of 0 asks for the same bits
+*/
+static int are_values_equal(const PREC reference, const PREC value, const PREC tolerance) {
+	PREC scale;
+
+	if ( IS_INVALID_VALUE(reference) || IS_INVALID_VALUE(value) ) {
+		return IS_INVALID_VALUE(reference) && IS_INVALID_VALUE(value);
+	}
+	scale = FABS(reference);
+	if ( scale < 1.0 ) {
+		scale = 1.0;
+	}
+	return FABS(value - reference) <= tolerance * scale;
+}
+
+/*
+	added on October 18, 2026
+
+	compares results of gf_mds_ref with the ones of the engine, first
+	diffs_max differences are stored in diffs and their number in
+	diffs_count. only FILLED and STDDEV use tolerance, returns rows
+	that differ
+*/
+int gf_ref_compare(const GF_ROW *const reference, const GF_ROW *const rows, const int rows_count, const PREC tolerance, GF_REF_DIFF *const diffs, const int diffs_max, int *const diffs_count) {
+	int i;
+	int field;
+	int differ;
+	int rows_differ;
+	PREC values[GF_REF_FIELDS][2];
+
+	assert(reference && rows && (!diffs_max || diffs) && diffs_count);
+
+	*diffs_count = 0;
+	rows_differ = 0;
+	for ( i = 0; i < rows_count; i++ ) {
+		values[GF_REF_FILLED][0] = reference[i].filled;
+		values[GF_REF_FILLED][1] = rows[i].filled;
+		values[GF_REF_STDDEV][0] = reference[i].stddev;
+		values[GF_REF_STDDEV][1] = rows[i].stddev;
+		values[GF_REF_SAMPLE][0] = reference[i].samples_count;
+		values[GF_REF_SAMPLE][1] = rows[i].samples_count;
+		values[GF_REF_METHOD][0] = reference[i].method;
+		values[GF_REF_METHOD][1] = rows[i].method;
+		values[GF_REF_TIMEWINDOW][0] = reference[i].time_window;
+		values[GF_REF_TIMEWINDOW][1] = rows[i].time_window;
+		values[GF_REF_QC][0] = reference[i].quality;
+		values[GF_REF_QC][1] = rows[i].quality;
+
+		differ = 0;
+		for ( field = 0; field < GF_REF_FIELDS; field++ ) {
+			if ( ((GF_REF_FILLED == field) || (GF_REF_STDDEV == field))
+					? are_values_equal(values[field][0], values[field][1], tolerance)
+					: (values[field][0] == values[field][1]) ) {
+				continue;
+			}
+			differ = 1;
+			if ( *diffs_count < diffs_max ) {
+				diffs[*diffs_count].row = i;
+				diffs[*diffs_count].field = field;
+				diffs[*diffs_count].reference = values[field][0];
+				diffs[*diffs_count].value = values[field][1];
+				++*diffs_count;
+			}
+		}
+		rows_differ += differ;
+	}
+
+	return rows_differ;
+}
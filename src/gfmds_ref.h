@@ -0,0 +1,85 @@
+/*
+	gfmds_ref.h
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	reference gapfilling engine and comparison of results, added on
+	October 18, 2026 (see gfmds_ref.c and -verify)
+*/
+
+#ifndef GFMDS_REF_H
+#define GFMDS_REF_H
+
+/* includes */
+#include "common.h"
+
+/* enums */
+enum {
+	GF_REF_FILLED = 0,
+	GF_REF_STDDEV,
+	GF_REF_SAMPLE,
+	GF_REF_METHOD,
+	GF_REF_TIMEWINDOW,
+	GF_REF_QC,
+
+	GF_REF_FIELDS
+};
+
+/* structures */
+typedef struct {
+	int row;
+	int field;
+	PREC reference;
+	PREC value;
+} GF_REF_DIFF;
+
+/* prototypes */
+GF_ROW *gf_mds_ref(	PREC *values,
+					const int struct_size,
+					const int rows_count,
+					const int columns_count,
+					const int timeres,
+					PREC value1_tolerance_min,
+					PREC value1_tolerance_max,
+					PREC value2_tolerance_min,
+					PREC value2_tolerance_max,
+					PREC value3_tolerance_min,
+					PREC value3_tolerance_max,
+					const int tofill_column,
+					const int value1_column,
+					const int value2_column,
+					const int value3_column,
+					const int value1_qc_column,
+					const int value2_qc_column,
+					const int value3_qc_column,
+					const int qc_thrs,
+					const int values_min,
+					const int compute_hat,
+					int start_row,
+					int end_row,
+					int *no_gaps_filled_count);
+const char *gf_ref_get_field_name(const int field);
+int gf_ref_compare(const GF_ROW *const reference, const GF_ROW *const rows, const int rows_count, const PREC tolerance, GF_REF_DIFF *const diffs, const int diffs_max, int *const diffs_count);
+
+#endif /* GFMDS_REF_H */
@@ -29,11 +29,63 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include <string.h>
 #include <assert.h>
 #include "dataset.h"
+#include "cache.h"
+#include "prefetch.h"
+#include "stats.h"
+#include "trace.h"
+#include "gfmds_ref.h"
+#include "writer.h"
+#include "output.h"
 #include "common.h"
 #include "compiler.h"
 
 /* constants */
 #define PROGRAM_VERSION		"2.02"
+#define THREADS_MAX			256
+#define JOBS_MAX			256
+#define PIPELINE_QUEUE_SIZE	1
+#define VERIFY_DIFFS_MAX	10
+
+/*
+	structures, added on October 18, 2026
+
+	a job is a group of files processed as one dataset. everything that
+	changes while processing it lives here so jobs can run concurrently
+*/
+typedef struct {
+	const FILES *files;
+	char filename[FILENAME_SIZE];
+	char tofill[GF_TOKEN_LENGTH_MAX+1];
+	long long size;
+	int valid;
+	int processed;
+	int no_gaps_filled_count;
+	ROW *rows;
+	GF_ROW *gf_rows;
+	CALENDAR calendar;
+	int verify_rows;						/* rows that differ from reference engine, -1 on error */
+	int verify_diffs_count;
+	GF_REF_DIFF verify_diffs[VERIFY_DIFFS_MAX];
+#if defined (GF_STATS)
+	STATS stats;
+#endif
+} JOB;
+
+typedef struct {
+	JOB **jobs;
+	int count;
+	int next;
+	MUTEX mutex;
+} SCHEDULER;
+
+typedef struct {
+	JOB *jobs;
+	int count;
+	QUEUE imported;
+	QUEUE filled;
+} PIPELINE;
+
+/* */
 const char def_tokens[GF_TOKENS][GF_TOKEN_LENGTH_MAX+1] =
 {
 	"NEE"
@@ -47,14 +99,35 @@ const char def_tokens[GF_TOKENS][GF_TOKEN_LENGTH_MAX+1] =
 static FILES *files;
 static int files_count;
 static int rows_min = GF_ROWS_MIN;								/* see types.h */
+static int use_cache = 0;
+static char *cache_path = NULL;
+static int compression = COMPRESSION_NONE;
+static int output_format = OUTPUT_FORMAT_CSV;
+static int threads_count = 0;									/* 0 means one per cpu */
+static int gaps_only = 0;
+static char *output_columns = NULL;
+static int jobs_count = 1;										/* 0 means one per cpu */
+static int pipeline = 0;
+static int use_prefetch = 0;
+static char *stats_path = NULL;
+static char *trace_path = NULL;
+static int use_perf = 0;
+static int verify = 0;
+static PREC verify_tolerance = 0.0;
+#if defined (GF_STATS)
+static TRACE *trace = NULL;
+#endif
+static JOB *jobs = NULL;
+static PREFETCH *prefetch = NULL;
+static OUTPUT_OPTIONS output_options;
+static GFMDS_PARAMS gf_params;
 
 /* global variables */
 char *program_path = NULL;										/* required */
 char *input_path = NULL;										/* required */
 char *output_path = NULL;										/* required */
 int timeres = HALFHOURLY_TIMERES;								/* required */
-int *years = NULL;												/* required */
-int years_count = 0;											/* required */
+int full_years = 0;												/* required */
 PREC driver1_tolerance_min = GF_DRIVER_1_TOLERANCE_MIN;			/* required */
 PREC driver1_tolerance_max = GF_DRIVER_1_TOLERANCE_MAX;			/* required */
 PREC driver2a_tolerance_min = GF_DRIVER_2A_TOLERANCE_MIN;		/* required */
@@ -76,9 +149,8 @@ static const char notes[] = "processed on %s with gf_mds "PROGRAM_VERSION" compi
 
 /* must have same order of eValues in types.h */
 char tokens[GF_TOKENS][GF_TOKEN_LENGTH_MAX+1];
-static const char gap_file[] = "%s%smds.csv";
-static const char gap_header[] = "%s,%s,FILLED,QC,HAT,SAMPLE,STDDEV,METHOD,QC_HAT,TIMEWINDOW\n";
-static const char gap_format[] = "%s,%g,%g,%d,%g,%d,%g,%d,%d,%d\n";
+static const char gap_file[] = "%s%smds%s%s";
+static const char cache_file[] = "%s%sdataset.gfb";
 
 /* messages */
 static const char msg_dataset_not_specified[] =
@@ -89,6 +161,10 @@ static const char msg_output_path[] = "output path = %s\n\n";
 static const char msg_rows_min[] = "rows min = %d\n\n";
 static const char msg_ok[] = "ok";
 static const char msg_ok_with_gaps_unfilled[] = "ok with %d gaps unfilled.\n";
+static const char msg_verify_ok[] = "verify: same results of reference engine.";
+static const char msg_verify_rows_differ[] = "verify: %d rows differ from reference engine, first differences:\n";
+static const char msg_verify_diff[] = "  %s %s: reference %.17g, engine %.17g\n";
+static const char msg_verify_failed[] = "\nverify: datasets that differ from reference engine: %d.\n";
 static const char msg_summary[] = "\n%d file%s found: %d processed, %d skipped.\n\n";
 static const char msg_usage[] =	"This code applies the gapfilling Marginal Distribution Sampling method\n"
 								"described in Reichstein et al. 2005 (Global Change Biology).\n The code has been validated against the original implementation.\nThis version "
@@ -118,6 +194,9 @@ static const char msg_usage[] =	"This code applies the gapfilling Marginal Distr
 								"  -output=path where result files are created (optional)\n"
 								"    (if not specified the folder with the program file is used)\n\n"
 								"  -hourly -> specify that your file is not halfhourly but hourly\n\n"
+								"  -quaterhourly -> specify that your file is not halfhourly but quaterhourly\n\n"
+								"  -full_years -> pad the dataset to whole calendar years\n"
+								"    (by default only the span covered by timestamps is processed)\n\n"
 								"  -tofill=XXXX -> name of the the variable to be filled as reported in\n    the header of the "
 								" input file (max %d chrs, default is \"%s\")\n\n"
 								"  -driver1=XXXX -> name of the name of the main driver (as in the header)\n    that is used in case using all the 3 drivers "
@@ -139,6 +218,36 @@ static const char msg_usage[] =	"This code applies the gapfilling Marginal Distr
 								"  -tdriver2b=min[,max] -> set the tolerance values used to define\n    similar conditions related to driver2b. "
 								"See description for tdriver1\n"
 								"    (default is one value for VPD in hPa and is %g)\n\n"
+								"  -compress=gz|zstd -> compress output files on the fly\n"
+								"    (compressed input files are always detected and read)\n\n"
+								"  -cache[=path] -> save imported datasets as binary gfb files and reuse them\n"
+								"    on next runs while input files are unchanged\n"
+								"    (if path is not specified the output path is used)\n\n"
+								"  -format=csv|bin -> set the format of output files (default: csv)\n"
+								"    bin writes mds.gfo files with typed columns that can be mapped\n"
+								"    directly in memory (see output.h for the layout)\n\n"
+								"  -columns=name[,name...] -> write only these columns after the timestamp\n"
+								"    (e.g. -columns=FILLED,QC, default: all of them)\n\n"
+								"  -rows=all|gaps -> write all rows or only the ones that were gaps\n"
+								"    (default: all)\n\n"
+								"  -threads=value -> set the number of threads used to format output files\n"
+								"    (default: one per cpu, shared among jobs)\n\n"
+								"  -jobs=value -> set the number of datasets processed at the same time\n"
+								"    bigger datasets are started first (default: 1, 0 means one per cpu)\n\n"
+								"  -pipeline -> overlap import, gapfilling and writing of consecutive\n"
+								"    datasets (used when jobs is 1)\n\n"
+								"  -prefetch -> read input files ahead in batches while datasets are\n"
+								"    imported (io_uring is used where available)\n\n"
+								"  -stats=filename -> write times and counters of each dataset as json\n"
+								"    (needs a build with stats, see make STATS=1)\n\n"
+								"  -trace=filename -> write a timeline of datasets, phases and gaps as\n"
+								"    chrome trace events (needs a build with stats, see make STATS=1)\n\n"
+								"  -verify[=tolerance] -> gapfill each dataset also with the reference\n"
+								"    engine and show rows where FILLED, STDDEV, SAMPLE, METHOD, TIMEWINDOW\n"
+								"    or QC differ. FILLED and STDDEV may differ by tolerance times the\n"
+								"    biggest of 1 and the reference value (default: 0, same values)\n\n"
+								"  -perf -> add cpu cycles, instructions, cache and branch misses of each\n"
+								"    phase to -stats (linux, needs a build with stats)\n\n"
 								"  -rows_min=value -> set the minimum number of rows with valid data\n"
 								"    to run the gapfilling (default: %d)\n\n"
 								"  -h -> show this help\n\n"
@@ -153,20 +262,40 @@ static const char err_unable_to_register_atexit[] = "unable to register clean-up
 static const char err_unable_create_output_path[] = "unable to create output path: %s.\n";
 static const char err_unable_to_convert_value_for[] = "unable to convert value \"%s\" for %s\n\n";
 static const char err_output_path_no_delimiter[] = "output path must terminating with a \"%c\"\n\n";
+static const char err_unable_to_gapfill[] = "%s\n\n";
 static const char err_unable_open_output_path[] = "unable to open output path.\n";
 static const char err_tolerances_not_specified[] = "tolerances not specified for %s\n\n";
 static const char err_no_min_tolerance[] = "no min tolerance available for %s\n\n";
 static const char err_unable_create_gap_file[] = "unable to create gap file.";
+static const char err_unable_write_gap_file[] = "unable to write gap file.";
+static const char err_unknown_compression[] = "unknown compression \"%s\". use gz or zstd.\n\n";
+static const char err_unknown_format[] = "unknown format \"%s\". use csv or bin.\n\n";
+static const char err_unknown_rows[] = "unknown rows \"%s\". use all or gaps.\n\n";
+static const char err_compression_not_supported[] = "%s compression is not supported by this build.\n\n";
 static const char err_unable_convert_tolerance[] = "unable to convert tolerance \"%s\" for %s.\n\n";
 static const char err_arg_needs_param[] = "%s parameter not specified.\n\n";
 static const char err_arg_no_needs_param[] = "%s no needs parameter.\n\n";
 static const char err_dataset_already_specified[] = "dataset already specified (%s)! \"%s\" skipped.\n";
 static const char err_output_already_specified[] = "output path already specified (%s)! \"%s\" skipped.\n";
+static const char err_cache_already_specified[] = "cache path already specified (%s)! \"%s\" skipped.\n";
 static const char err_unable_create_output_filename[] = "unable to create output filename.\n";
+static const char err_jobs_count[] = "jobs must be between 0 and %d not %d. default value (1) will be used\n\n";
+static const char err_threads_count[] = "threads must be between 0 and %d not %d. default value (0) will be used\n\n";
+#if defined (GF_STATS)
+static const char err_unable_write_stats[] = "unable to write stats to %s.\n";
+static const char err_unable_write_trace[] = "unable to write trace to %s.\n";
+static const char err_perf_not_available[] = "hardware counters are not available, -perf ignored.\n";
+#else
+static const char err_stats_not_supported[] = "stats are not supported by this build, use make STATS=1.\n\n";
+#endif
+static const char err_verify_failed[] = "verify: reference engine failed.";
 static const char err_rows_min[] = "rows_min must be between %d and %d not %d. default value (%d) will be used";
 
 /* */
 static void clean_up(void) {
+	if ( jobs ) {
+		free(jobs);
+	}
 	if ( files ) {
 		free_files(files, files_count);
 	}
@@ -212,6 +341,97 @@ int get_output_path(char *arg, char *param, void *p) {
 	return 1;
 }
 
+/* added on October 18, 2026 */
+static int set_cache_path(char *arg, char *param, void *p) {
+	if ( use_cache ) {
+		printf(err_cache_already_specified, cache_path ? cache_path : "", param ? param : "");
+	} else {
+		use_cache = 1;
+		cache_path = param;
+	}
+
+	/* ok */
+	return 1;
+}
+
+/* added on October 18, 2026 */
+static int set_compression(char *arg, char *param, void *p) {
+	if ( !param ) {
+		printf(err_arg_needs_param, arg);
+		return 0;
+	}
+
+	if ( !string_compare_i(param, "gz") || !string_compare_i(param, "gzip") ) {
+		compression = COMPRESSION_GZIP;
+	} else if ( !string_compare_i(param, "zstd") || !string_compare_i(param, "zst") ) {
+		compression = COMPRESSION_ZSTD;
+	} else {
+		printf(err_unknown_compression, param);
+		return 0;
+	}
+
+	if ( !is_compression_supported(compression) ) {
+		printf(err_compression_not_supported, param);
+		return 0;
+	}
+
+	/* ok */
+	return 1;
+}
+
+/* added on October 18, 2026: p is stats_path or trace_path */
+static int set_stats_path(char *arg, char *param, void *p) {
+	if ( !param || !param[0] ) {
+		printf(err_arg_needs_param, arg);
+		return 0;
+	}
+#if defined (GF_STATS)
+	*(char **)p = param;
+
+	/* ok */
+	return 1;
+#else
+	puts(err_stats_not_supported);
+	return 0;
+#endif
+}
+
+/* added on October 18, 2026 */
+static int set_perf(char *arg, char *param, void *p) {
+	if ( param ) {
+		printf(err_arg_no_needs_param, arg);
+		return 0;
+	}
+#if defined (GF_STATS)
+	*((int *)p) = 1;
+
+	/* ok */
+	return 1;
+#else
+	puts(err_stats_not_supported);
+	return 0;
+#endif
+}
+
+/* added on October 18, 2026 */
+static int set_verify(char *arg, char *param, void *p) {
+	int error;
+	PREC value;
+
+	if ( param ) {
+		value = convert_string_to_prec(param, &error);
+		if ( error || (value < 0.0) ) {
+			printf(err_unable_to_convert_value_for, param, arg);
+			return 0;
+		}
+		verify_tolerance = value;
+	}
+	verify = 1;
+
+	/* ok */
+	return 1;
+}
+
 /* */
 int set_hourly_dataset(char *arg, char *param, void *p) {
 	if ( param ) {
@@ -225,6 +445,73 @@ int set_hourly_dataset(char *arg, char *param, void *p) {
 	return 1;
 }
 
+/* added on October 18, 2026 */
+static int set_quaterhourly_dataset(char *arg, char *param, void *p) {
+	if ( param ) {
+		printf(err_arg_no_needs_param, arg);
+		return 0;
+	}
+
+	timeres = QUATERHOURLY_TIMERES;
+
+	/* ok */
+	return 1;
+}
+
+/* added on October 18, 2026 */
+static int set_output_format(char *arg, char *param, void *p) {
+	if ( !param ) {
+		printf(err_arg_needs_param, arg);
+		return 0;
+	}
+
+	if ( !string_compare_i(param, "csv") ) {
+		output_format = OUTPUT_FORMAT_CSV;
+	} else if ( !string_compare_i(param, "bin") ) {
+		output_format = OUTPUT_FORMAT_BIN;
+	} else {
+		printf(err_unknown_format, param);
+		return 0;
+	}
+
+	/* ok */
+	return 1;
+}
+
+/* added on October 18, 2026 */
+static int set_output_columns(char *arg, char *param, void *p) {
+	if ( !param ) {
+		printf(err_arg_needs_param, arg);
+		return 0;
+	}
+
+	/* names are checked once tokens are known */
+	output_columns = param;
+
+	/* ok */
+	return 1;
+}
+
+/* added on October 18, 2026 */
+static int set_output_rows(char *arg, char *param, void *p) {
+	if ( !param ) {
+		printf(err_arg_needs_param, arg);
+		return 0;
+	}
+
+	if ( !string_compare_i(param, "all") ) {
+		gaps_only = 0;
+	} else if ( !string_compare_i(param, "gaps") ) {
+		gaps_only = 1;
+	} else {
+		printf(err_unknown_rows, param);
+		return 0;
+	}
+
+	/* ok */
+	return 1;
+}
+
 /* */
 static int set_token(char *arg, char *param, void *p) {
 	int i;
@@ -413,27 +700,575 @@ void show_tolerances(void) {
 	puts("\n");
 }
 
+/* added on October 18, 2026 */
+static void show_job_name(const JOB *const job) {
+	int i;
+
+	for ( i = 0; i < job->files->count; i++ ) {
+		if ( !i ) {
+			printf(msg_import_dataset, job->files->list[i].name, (job->files->count>1) ? "+" : "...");
+		} else {
+			printf("%s%s", job->files->list[i].name, (job->files->count-1 == i) ? "..." : "+");
+		}
+	}
+}
+
+/* added on October 18, 2026 */
+static void show_job_result(const JOB *const job) {
+	int i;
+	char buffer[TIMESTAMP_STRING_SIZE];
+
+	if ( !job->processed ) {
+		return;
+	}
+	if ( !job->no_gaps_filled_count ) {
+		puts(msg_ok);
+	} else {
+		printf(msg_ok_with_gaps_unfilled, job->no_gaps_filled_count);
+	}
+
+	/* added on October 18, 2026 */
+	if ( verify ) {
+		if ( -1 == job->verify_rows ) {
+			puts(err_verify_failed);
+		} else if ( !job->verify_rows ) {
+			puts(msg_verify_ok);
+		} else {
+			printf(msg_verify_rows_differ, job->verify_rows);
+			for ( i = 0; i < job->verify_diffs_count; i++ ) {
+				printf(msg_verify_diff,
+							calendar_get_by_row_s_r(&job->calendar, job->verify_diffs[i].row, 0, buffer),
+							gf_ref_get_field_name(job->verify_diffs[i].field),
+							job->verify_diffs[i].reference,
+							job->verify_diffs[i].value
+				);
+			}
+		}
+	}
+}
+
+/*
+	added on October 18, 2026
+
+	shows name and result together so lines of jobs that
+	are processed concurrently don't mix
+*/
+static void show_job(const JOB *const job) {
+	show_job_name(job);
+	if ( !job->processed ) {
+		puts("");
+	}
+	show_job_result(job);
+	fflush(stdout);
+}
+
+/* added on October 18, 2026, returns 0 if out of memory */
+static int prepare_job(JOB *const job, const FILES *const files) {
+	int i;
+	int y;
+	long long size;
+	char *p;
+	char *string;
+
+	job->files = files;
+	job->filename[0] = '\0';
+	job->size = 0;
+	job->valid = 1;
+	job->processed = 0;
+	job->no_gaps_filled_count = 0;
+	job->verify_rows = 0;
+	job->verify_diffs_count = 0;
+	job->rows = NULL;
+	job->gf_rows = NULL;
+	strcpy(job->tofill, tokens[GF_TOFILL]);
+#if defined (GF_STATS)
+	memset(&job->stats, 0, sizeof job->stats);
+#endif
+
+	/* create output filename */
+	for ( i = 0; i < files->count; i++ ) {
+		string = string_copy(files->list[i].name);
+		if ( !string ) {
+			puts(err_out_of_memory);
+			return 0;
+		}
+
+		/* remove compression extension, updated on October 18, 2026 */
+		for ( y = COMPRESSION_NONE+1; y < COMPRESSIONS_COUNT; y++ ) {
+			p = strrchr(string, '.');
+			if ( p && !string_compare_i(p, get_compression_extension(y)) ) {
+				*p = '\0';
+				break;
+			}
+		}
+
+		/* check for extension */
+		p = strrchr(string, '.');
+		if ( p ) {
+			/* remove extension */
+			*p = '\0';
+		}
+
+		/* add to filename and underscore */
+		if ( !string_concat(job->filename, string, FILENAME_SIZE)
+				|| !add_char_to_string(job->filename, '_', FILENAME_SIZE) ) {
+			puts(err_unable_create_output_filename);
+			job->valid = 0;
+		}
+
+		/* free memory */
+		free(string);
+
+		/* size is used only for scheduling */
+		size = get_file_size(files->list[i].fullpath);
+		if ( size > 0 ) {
+			job->size += size;
+		}
+	}
+
+	return 1;
+}
+
+/*
+	added on October 18, 2026
+
+	a job is processed in three stages (import, fill and write) so they can
+	be pipelined. a stage runs only if the previous one succeeded and frees
+	what is no longer needed on error. globals are only read, so jobs can
+	run concurrently
+*/
+static void import_job(JOB *const job) {
+	int i;
+	char buffer[BUFFER_SIZE];
+
+	job->rows = NULL;
+	if ( !job->valid ) {
+		return;
+	}
+
+#if defined (GF_STATS)
+	stats_phase_start(&job->stats.import);
+#endif
+	if ( cache_path ) {
+		sprintf(buffer, cache_file, cache_path, job->filename);
+		job->rows = cache_load(buffer, job->files->list, job->files->count, &job->calendar, job->tofill);
+	}
+	if ( !job->rows ) {
+		job->rows = import_dataset(job->files->list, job->files->count, &job->calendar, job->tofill, prefetch);
+
+		/* a cache that can't be saved is not an error */
+		if ( job->rows && cache_path ) {
+			cache_save(buffer, job->files->list, job->files->count, job->rows, &job->calendar, job->tofill);
+		}
+	}
+
+	/* files not parsed (cache hit or error) are no longer needed */
+	if ( prefetch ) {
+		for ( i = 0; i < job->files->count; i++ ) {
+			prefetch_discard(prefetch, job->files->list[i].fullpath);
+		}
+	}
+#if defined (GF_STATS)
+	stats_phase_stop(&job->stats.import);
+	if ( trace ) {
+		trace_span(trace, "import", job->filename, job->stats.import.start, job->stats.import.end);
+	}
+#endif
+}
+
+#if defined (GF_STATS)
+/* added on October 18, 2026: end of last phase of job */
+static double get_job_end(const JOB *const job) {
+	double end;
+
+	end = job->stats.import.end;
+	if ( job->stats.fill.end > end ) {
+		end = job->stats.fill.end;
+	}
+	if ( job->stats.output.end > end ) {
+		end = job->stats.output.end;
+	}
+	return end;
+}
+
+/* added on October 18, 2026: p is the job */
+static void trace_job_run(const GFMDS_TRACE_RUN *const run, void *const p) {
+	trace_run(trace, ((const JOB *)p)->filename, run);
+}
+#endif
+
+/*
+	added on October 18, 2026
+
+	gapfills rows of job with the reference engine and compares
+	results with the ones of the engine
+*/
+static void verify_job(JOB *const job) {
+	int no_gaps_filled_count;
+	GF_ROW *gf_rows;
+
+	gf_rows = gf_mds_ref(	job->rows->value,
+							sizeof(ROW),
+							job->calendar.rows_count,
+							GF_REQUIRED_DATASET_VALUES,
+							timeres,
+							driver1_tolerance_min,
+							driver1_tolerance_max,
+							driver2a_tolerance_min,
+							driver2a_tolerance_max,
+							driver2b_tolerance_min,
+							driver2b_tolerance_max,
+							GF_TOFILL,
+							GF_DRIVER_1,
+							GF_DRIVER_2A,
+							GF_DRIVER_2B,
+							-1,
+							-1,
+							-1,
+							INVALID_VALUE,
+							rows_min,
+							1,
+							0,
+							-1,
+							&no_gaps_filled_count
+	);
+	if ( !gf_rows ) {
+		job->verify_rows = -1;
+		return;
+	}
+	job->verify_rows = gf_ref_compare(gf_rows, job->gf_rows, job->calendar.rows_count, verify_tolerance, job->verify_diffs, VERIFY_DIFFS_MAX, &job->verify_diffs_count);
+	free(gf_rows);
+}
+
+/* updated on October 18, 2026: each job uses its own gfmds context */
+static void fill_job(JOB *const job) {
+	int error;
+	GFMDS_CONTEXT *context;
+
+	job->gf_rows = NULL;
+	if ( !job->rows ) {
+		return;
+	}
+
+#if defined (GF_STATS)
+	stats_phase_start(&job->stats.fill);
+#endif
+	job->gf_rows = malloc(job->calendar.rows_count*sizeof*job->gf_rows);
+	context = gfmds_create(&gf_params);
+	if ( !job->gf_rows || !context ) {
+		error = GFMDS_ERR_OUT_OF_MEMORY;
+	} else {
+#if defined (GF_STATS)
+		if ( trace ) {
+			gfmds_set_trace_callback(context, trace_job_run, job);
+		}
+#endif
+		error = gfmds_fill(context, job->rows->value, sizeof(ROW), job->calendar.rows_count, job->gf_rows);
+		job->no_gaps_filled_count = gfmds_get_no_gaps_filled_count(context);
+#if defined (GF_STATS)
+		gfmds_get_stats(context, &job->stats.engine);
+#endif
+	}
+	gfmds_destroy(context);
+#if defined (GF_STATS)
+	stats_phase_stop(&job->stats.fill);
+	if ( trace ) {
+		trace_span(trace, "fill", job->filename, job->stats.fill.start, job->stats.fill.end);
+	}
+	if ( GFMDS_OK == error ) {
+		stats_count_filled(&job->stats, job->gf_rows, job->calendar.rows_count);
+		job->stats.no_gaps_filled_count = job->no_gaps_filled_count;
+	}
+#endif
+
+	if ( (GFMDS_OK == error) && verify ) {
+		verify_job(job);
+	}
+
+	if ( GFMDS_OK != error ) {
+		printf(err_unable_to_gapfill, gfmds_get_error_string(error));
+		free(job->gf_rows);
+		free(job->rows);
+		job->gf_rows = NULL;
+		job->rows = NULL;
+	}
+}
+
+/* added on October 18, 2026 */
+static void write_job(JOB *const job) {
+	char buffer[BUFFER_SIZE];
+	WRITER *f;
+	OUTPUT_OPTIONS options;
+
+	if ( !job->gf_rows ) {
+		return;
+	}
+
+#if defined (GF_STATS)
+	stats_phase_start(&job->stats.output);
+#endif
+	/* create output file */
+	sprintf(buffer, gap_file, output_path, job->filename, get_output_format_extension(output_options.format), get_compression_extension(compression));
+	f = writer_open(buffer, compression, OUTPUT_FORMAT_BIN == output_options.format);
+	if ( !f ) {
+		puts(err_unable_create_gap_file);
+	} else {
+		/* write header and values */
+		options = output_options;
+		options.tofill = job->tofill;
+		if ( !output_write(f, &options, job->rows, job->gf_rows, &job->calendar) ) {
+			writer_close(f);
+			puts(err_unable_write_gap_file);
+		} else if ( !writer_close(f) ) {
+			puts(err_unable_write_gap_file);
+		} else {
+			job->processed = 1;
+		}
+	}
+
+	/* free memory */
+	free(job->gf_rows);
+	free(job->rows);
+	job->gf_rows = NULL;
+	job->rows = NULL;
+#if defined (GF_STATS)
+	stats_phase_stop(&job->stats.output);
+	job->stats.peak_memory = stats_get_peak_memory();
+	if ( trace ) {
+		trace_span(trace, "output", job->filename, job->stats.output.start, job->stats.output.end);
+	}
+#endif
+}
+
+/* added on October 18, 2026 */
+static void run_job(JOB *const job) {
+	import_job(job);
+	fill_job(job);
+	write_job(job);
+}
+
+/* added on October 18, 2026, bigger jobs first */
+static int compare_jobs_by_size(const void *a, const void *b) {
+	const JOB *job_a = *(const JOB *const *)a;
+	const JOB *job_b = *(const JOB *const *)b;
+
+	if ( job_a->size != job_b->size ) {
+		return (job_a->size > job_b->size) ? -1 : 1;
+	}
+	/* keep input order */
+	return (job_a < job_b) ? -1 : (job_a > job_b);
+}
+
+/*
+	added on October 18, 2026
+
+	starts reading files of valid jobs in the order they will be imported.
+	returns NULL on error (files are then read by import_dataset)
+*/
+static PREFETCH *prefetch_jobs(JOB *const list, const int count) {
+	int i;
+	int y;
+	int n;
+	const char **filenames;
+	JOB **sorted;
+	PREFETCH *p;
+
+	n = 0;
+	for ( i = 0; i < count; i++ ) {
+		if ( list[i].valid ) {
+			n += list[i].files->count;
+		}
+	}
+	if ( !n ) {
+		return NULL;
+	}
+
+	sorted = malloc(count*sizeof*sorted);
+	filenames = malloc(n*sizeof*filenames);
+	if ( !sorted || !filenames ) {
+		free(filenames);
+		free(sorted);
+		return NULL;
+	}
+	for ( i = 0; i < count; i++ ) {
+		sorted[i] = &list[i];
+	}
+	if ( jobs_count > 1 ) {
+		qsort(sorted, count, sizeof*sorted, compare_jobs_by_size);
+	}
+	n = 0;
+	for ( i = 0; i < count; i++ ) {
+		if ( sorted[i]->valid ) {
+			for ( y = 0; y < sorted[i]->files->count; y++ ) {
+				filenames[n++] = sorted[i]->files->list[y].fullpath;
+			}
+		}
+	}
+	p = prefetch_open(filenames, n);
+	free(filenames);
+	free(sorted);
+
+	return p;
+}
+
+/* added on October 18, 2026 */
+static void job_thread(void *p) {
+	JOB *job;
+	SCHEDULER *scheduler;
+
+	scheduler = p;
+	for ( ; ; ) {
+		mutex_lock(&scheduler->mutex);
+		job = (scheduler->next < scheduler->count) ? scheduler->jobs[scheduler->next++] : NULL;
+		mutex_unlock(&scheduler->mutex);
+		if ( !job ) {
+			break;
+		}
+
+		run_job(job);
+
+		mutex_lock(&scheduler->mutex);
+		show_job(job);
+		mutex_unlock(&scheduler->mutex);
+	}
+}
+
+/*
+	added on October 18, 2026
+
+	runs jobs on a pool of threads_count threads, returns 0 if the pool
+	can't be created (jobs are then run serially by the caller)
+*/
+static int run_jobs_concurrently(JOB *const list, const int count, int threads_count) {
+	int i;
+	int threads_started;
+	THREAD *threads;
+	SCHEDULER scheduler;
+
+	if ( threads_count > count ) {
+		threads_count = count;
+	}
+
+	scheduler.jobs = malloc(count*sizeof*scheduler.jobs);
+	threads = malloc(threads_count*sizeof*threads);
+	if ( !scheduler.jobs || !threads || !mutex_init(&scheduler.mutex) ) {
+		free(threads);
+		free(scheduler.jobs);
+		return 0;
+	}
+	for ( i = 0; i < count; i++ ) {
+		scheduler.jobs[i] = &list[i];
+	}
+	qsort(scheduler.jobs, count, sizeof*scheduler.jobs, compare_jobs_by_size);
+	scheduler.count = count;
+	scheduler.next = 0;
+
+	/* calling thread is one of them */
+	for ( threads_started = 0; threads_started < threads_count-1; threads_started++ ) {
+		if ( !thread_create(&threads[threads_started], job_thread, &scheduler) ) {
+			break;
+		}
+	}
+
+	job_thread(&scheduler);
+
+	for ( i = 0; i < threads_started; i++ ) {
+		thread_join(&threads[i]);
+	}
+	mutex_destroy(&scheduler.mutex);
+	free(threads);
+	free(scheduler.jobs);
+
+	return 1;
+}
+
+/* added on October 18, 2026 */
+static void import_stage(void *p) {
+	int i;
+	PIPELINE *pipeline;
+
+	pipeline = p;
+	for ( i = 0; i < pipeline->count; i++ ) {
+		import_job(&pipeline->jobs[i]);
+		queue_push(&pipeline->imported, &pipeline->jobs[i]);
+	}
+}
+
+/* added on October 18, 2026 */
+static void fill_stage(void *p) {
+	int i;
+	JOB *job;
+	PIPELINE *pipeline;
+
+	pipeline = p;
+	for ( i = 0; i < pipeline->count; i++ ) {
+		job = queue_pop(&pipeline->imported);
+		fill_job(job);
+		queue_push(&pipeline->filled, job);
+	}
+}
+
+/*
+	added on October 18, 2026
+
+	import of job z+1, gapfilling of job z and writing of job z-1 overlap.
+	each stage has its own thread (the calling one writes) and stages are
+	linked by queues of PIPELINE_QUEUE_SIZE jobs, so at most a few datasets
+	are in memory. returns 0 if the pipeline can't be created
+*/
+static int run_jobs_pipelined(JOB *const list, const int count) {
+	int i;
+	JOB *job;
+	THREAD importer;
+	THREAD filler;
+	PIPELINE pipeline;
+
+	pipeline.jobs = list;
+	pipeline.count = count;
+	if ( !queue_init(&pipeline.imported, PIPELINE_QUEUE_SIZE) ) {
+		return 0;
+	}
+	if ( !queue_init(&pipeline.filled, PIPELINE_QUEUE_SIZE) ) {
+		queue_destroy(&pipeline.imported);
+		return 0;
+	}
+	if ( !thread_create(&importer, import_stage, &pipeline) ) {
+		queue_destroy(&pipeline.filled);
+		queue_destroy(&pipeline.imported);
+		return 0;
+	}
+	if ( !thread_create(&filler, fill_stage, &pipeline) ) {
+		/* fill and write here, only import overlaps */
+		for ( i = 0; i < count; i++ ) {
+			job = queue_pop(&pipeline.imported);
+			fill_job(job);
+			write_job(job);
+			show_job(job);
+		}
+	} else {
+		/* jobs leave the pipeline in input order */
+		for ( i = 0; i < count; i++ ) {
+			job = queue_pop(&pipeline.filled);
+			write_job(job);
+			show_job(job);
+		}
+		thread_join(&filler);
+	}
+	thread_join(&importer);
+	queue_destroy(&pipeline.filled);
+	queue_destroy(&pipeline.imported);
+
+	return 1;
+}
+
 /* */
 int main(int argc, char *argv[]) {
 	int i;
-	int y;
 	int z;
-	int j;
-	int k;
-	int w;
 	int error;
-	int rows_count;
 	int files_processed_count;
 	int files_not_processed_count;
 	int total_files_count;
-	int no_gaps_filled_count;
-	char buffer[BUFFER_SIZE];
-	char filename[FILENAME_SIZE];
-	char *p;
-	char *string;
-	FILE *f;
-	ROW *rows;
-	GF_ROW *gf_rows;
 
 	TOLERANCE tol1 = { "driver1", &driver1_tolerance_min, &driver1_tolerance_max };
 	TOLERANCE tol2a = { "driver2a", &driver2a_tolerance_min, &driver2a_tolerance_max };
@@ -443,6 +1278,8 @@ int main(int argc, char *argv[]) {
 		{ "input", get_input_path, NULL },
 		{ "output", get_output_path, NULL },
 		{ "hourly", set_hourly_dataset, NULL },
+		{ "quaterhourly", set_quaterhourly_dataset, NULL },
+		{ "full_years", set_flag, &full_years },
 		{ "tofill", set_token, (void *)GF_TOFILL },
 		{ "driver1", set_token, (void *)GF_DRIVER_1 },
 		{ "driver2a", set_token, (void *)GF_DRIVER_2A },		
@@ -452,6 +1289,19 @@ int main(int argc, char *argv[]) {
 		{ "tdriver2a", set_driver_tolerances, &tol2a },
 		{ "tdriver2b", set_driver_tolerances, &tol2b },
 		{ "rows_min", set_int_value, &rows_min },
+		{ "cache", set_cache_path, NULL },
+		{ "compress", set_compression, NULL },
+		{ "format", set_output_format, NULL },
+		{ "columns", set_output_columns, NULL },
+		{ "rows", set_output_rows, NULL },
+		{ "threads", set_int_value, &threads_count },
+		{ "jobs", set_int_value, &jobs_count },
+		{ "pipeline", set_flag, &pipeline },
+		{ "prefetch", set_flag, &use_prefetch },
+		{ "stats", set_stats_path, &stats_path },
+		{ "trace", set_stats_path, &trace_path },
+		{ "perf", set_perf, &use_perf },
+		{ "verify", set_verify, NULL },
 		{ "h", show_help, NULL },
 		{ "?", show_help, NULL },
 		{ "help", show_help, NULL },
@@ -508,6 +1358,25 @@ int main(int argc, char *argv[]) {
 		output_path = program_path;
 	}
 
+	/* cache path specified ? */
+	if ( cache_path ) {
+		/* check if last char is a FOLDER_DELIMITER */
+		if ( cache_path[strlen(cache_path)-1] != FOLDER_DELIMITER ) {
+			printf(err_output_path_no_delimiter, FOLDER_DELIMITER);
+			return 1;
+		}
+
+		/* check if cache path exists */
+		if ( !path_exists(cache_path) ) {
+			if ( !create_dir(cache_path) ) {
+				printf(err_unable_create_output_path, cache_path);
+				return 1;
+			}
+		}
+	} else if ( use_cache ) {
+		cache_path = output_path;
+	}
+
 	/* get files */
 	files = get_files(program_path, input_path, &files_count, &error);
 	if ( error ) {
@@ -526,6 +1395,24 @@ int main(int argc, char *argv[]) {
 		printf(msg_rows_min, rows_min);
 	}
 
+	/* threads */
+	if ( (threads_count < 0) || (threads_count > THREADS_MAX) ) {
+		printf(err_threads_count, THREADS_MAX, threads_count);
+		threads_count = 0;
+	}
+	if ( !threads_count ) {
+		threads_count = get_cpus_count();
+	}
+
+	/* jobs */
+	if ( (jobs_count < 0) || (jobs_count > JOBS_MAX) ) {
+		printf(err_jobs_count, JOBS_MAX, jobs_count);
+		jobs_count = 1;
+	}
+	if ( !jobs_count ) {
+		jobs_count = get_cpus_count();
+	}
+
 	/* assign columns names */
 	for ( i = 0; i < GF_TOKENS; i++ ) {
 		if ( !custom_tokens[i] ) {
@@ -534,147 +1421,126 @@ int main(int argc, char *argv[]) {
 		}
 	}
 
+	/* output options */
+	output_options_default(&output_options);
+	output_options.format = output_format;
+	output_options.gaps_only = gaps_only;
+	/* formatting threads are shared among jobs running together */
+	output_options.threads_count = (jobs_count > 1) ? threads_count / jobs_count : threads_count;
+	if ( output_options.threads_count < 1 ) {
+		output_options.threads_count = 1;
+	}
+	if ( output_columns && !output_set_columns(&output_options, output_columns) ) {
+		return 1;
+	}
+
 	/* show tolerances */
 	show_tolerances();
 
-	/* reset */
-	files_processed_count = 0;
-	files_not_processed_count = 0;
-	total_files_count = 0;
-
-	/* loop for searching file */
-	for ( z = 0; z < files_count; z++) {
-		/* inc total files founded */
-		total_files_count += files[z].count;
+	/* gapfilling parameters */
+	gfmds_params_default(&gf_params);
+	gf_params.timeres = timeres;
+	gf_params.driver1_tolerance_min = driver1_tolerance_min;
+	gf_params.driver1_tolerance_max = driver1_tolerance_max;
+	gf_params.driver2a_tolerance_min = driver2a_tolerance_min;
+	gf_params.driver2a_tolerance_max = driver2a_tolerance_max;
+	gf_params.driver2b_tolerance_min = driver2b_tolerance_min;
+	gf_params.driver2b_tolerance_max = driver2b_tolerance_max;
+	gf_params.tofill_column = GF_TOFILL;
+	gf_params.driver1_column = GF_DRIVER_1;
+	gf_params.driver2a_column = GF_DRIVER_2A;
+	gf_params.driver2b_column = GF_DRIVER_2B;
+	gf_params.values_min = rows_min;
+	gf_params.compute_hat = 1;
+
+	/* prepare jobs */
+	jobs = malloc(files_count*sizeof*jobs);
+	if ( !jobs ) {
+		puts(err_out_of_memory);
+		return 1;
+	}
+	for ( z = 0; z < files_count; z++ ) {
+		if ( !prepare_job(&jobs[z], &files[z]) ) {
+			return 1;
+		}
+	}
 
-		/* processing and create output filename */
-		filename[0] = '\0';
-		for ( i = 0; i < files[z].count; i++ ) {
-			if ( !i ) {
-				printf(msg_import_dataset, files[z].list[i].name, (files[z].count>1) ? "+" : "...");
-			} else {
-				printf(files[z].list[i].name);
-				if ( files[z].count-1 == i ) {
-					printf("...");
-				} else {
-					printf("+");
-				}
-			}
-			string = string_copy(files[z].list[i].name);
-			if ( !string ) {
-				puts(err_out_of_memory);
-				return 1;
-			}
+#if defined (GF_STATS)
+	/* hardware counters */
+	if ( use_perf && !stats_enable_counters() ) {
+		puts(err_perf_not_available);
+	}
 
-			/* check for extension */
-			p = strrchr(string, '.');
-			if ( p ) {
-				/* remove extension */
-				*p = '\0';
-			}
+	/* timeline */
+	if ( trace_path ) {
+		trace = trace_open(trace_path);
+		if ( !trace ) {
+			printf(err_unable_write_trace, trace_path);
+		}
+	}
+#endif
 
-			/* add to filename */
-			if ( !string_concat(filename, string, FILENAME_MAX) && '\0' == filename[0]) {
-				puts(err_unable_create_output_filename);
-				files_not_processed_count += files[z].count;
-				free(string);
-				continue;
-			}
+	/* read input files ahead */
+	if ( use_prefetch ) {
+		prefetch = prefetch_jobs(jobs, files_count);
+	}
 
-			/* add underscore */
-			if ( !add_char_to_string(filename, '_', FILENAME_MAX) && '\0' == filename[0]) {
-				puts(err_unable_create_output_filename);
-				files_not_processed_count += files[z].count;
-				free(string);
-				continue;
+	/* process */
+	if ( (files_count < 2)
+			|| ((jobs_count > 1) && !run_jobs_concurrently(jobs, files_count, jobs_count))
+			|| ((1 == jobs_count) && (!pipeline || !run_jobs_pipelined(jobs, files_count))) ) {
+		for ( z = 0; z < files_count; z++ ) {
+			show_job_name(&jobs[z]);
+			run_job(&jobs[z]);
+			show_job_result(&jobs[z]);
+		}
+	}
+	prefetch_close(prefetch);
+	prefetch = NULL;
+
+#if defined (GF_STATS)
+	/* stats of imported datasets */
+	if ( stats_path ) {
+		FILE *f;
+
+		f = stats_open(stats_path);
+		if ( f ) {
+			i = 0;
+			for ( z = 0; z < files_count; z++ ) {
+				if ( jobs[z].valid ) {
+					stats_write_job(f, i++, jobs[z].filename, files[z].count, &jobs[z].stats);
+				}
 			}
-
-			/* free memory */
-			free(string);
 		}
-
-		/* import dataset */
-		rows = import_dataset(files[z].list, files[z].count, &rows_count); 
-		if ( !rows ) {
-			free(years);
-			files_not_processed_count += files[z].count;
-			continue;
-		}
-
-		/* gf */
-		gf_rows = gf_mds(rows->value, sizeof(ROW), rows_count, GF_REQUIRED_DATASET_VALUES, timeres
-								, driver1_tolerance_min, driver1_tolerance_max
-								, driver2a_tolerance_min, driver2a_tolerance_max
-								, driver2b_tolerance_min , driver2b_tolerance_max
-								, GF_TOFILL, GF_DRIVER_1, GF_DRIVER_2A, GF_DRIVER_2B, rows_min, 1, &no_gaps_filled_count);
-		if ( !gf_rows ) {
-			free(years);
-			free(rows);
-			files_not_processed_count += files[z].count;
-			continue;
+		if ( !f || !stats_close(f) ) {
+			printf(err_unable_write_stats, stats_path);
 		}
+	}
 
-		/* create output file */
-		sprintf(buffer, gap_file, output_path, filename);
-		f = fopen(buffer, "w");
-		if ( !f ) {
-			puts(err_unable_create_gap_file);
-			free(years);
-			free(rows);
-			files_not_processed_count += files[z].count;
-			continue;
-		}
-
-		/* write header */
-		fprintf(f, gap_header, tokens[GF_ROW_INDEX], tokens[GF_TOFILL]);
-		
-		/* write values */
-		for ( y = 0; y < files[z].count; y++ ) {
-			y = 0;
-			w = 0;
-			/* updated on January 17, 2018 */
-			j = get_rows_count_by_timeres(timeres, years[y]);
-			
-			/* */
-			for ( i = 0; i < rows_count; i++ ) {
-				if ( i == j ) {
-					++y;
-					k = get_rows_count_by_timeres(timeres, years[y]);
-					j += k;
-					k = get_rows_count_by_timeres(timeres,years[y-1]);
-					w += k;
-				}
-				fprintf(f, gap_format,
-										timestamp_end_by_row_s(i-w, years[y], timeres),
-										rows[i].value[GF_TOFILL],
-										IS_FLAG_SET(gf_rows[i].mask, GF_TOFILL_VALID) ? rows[i].value[GF_TOFILL] : gf_rows[i].filled,
-										IS_FLAG_SET(gf_rows[i].mask, GF_TOFILL_VALID) ? 0 : gf_rows[i].quality,
-										gf_rows[i].filled,									
-										gf_rows[i].samples_count,
-										gf_rows[i].stddev,
-										gf_rows[i].method,
-										gf_rows[i].quality,
-										gf_rows[i].time_window
-				);
+	/* file groups from their first to their last phase */
+	if ( trace ) {
+		for ( z = 0; z < files_count; z++ ) {
+			if ( jobs[z].valid ) {
+				trace_group(trace, z, jobs[z].filename, jobs[z].stats.import.start, get_job_end(&jobs[z]));
 			}
 		}
+		if ( !trace_close(trace) ) {
+			printf(err_unable_write_trace, trace_path);
+		}
+		trace = NULL;
+	}
+#endif
 
-		/* close file */
-		fclose(f);
-
-		/* free memory */
-		free(gf_rows);
-		free(years);
-		free(rows);
-		
-		/* increment processed files count */
-		files_processed_count += files[z].count;
-
-		/* */
-		if ( !no_gaps_filled_count ) {
-			puts(msg_ok);
+	/* count */
+	files_processed_count = 0;
+	files_not_processed_count = 0;
+	total_files_count = 0;
+	for ( z = 0; z < files_count; z++ ) {
+		total_files_count += files[z].count;
+		if ( jobs[z].processed ) {
+			files_processed_count += files[z].count;
 		} else {
-			printf(msg_ok_with_gaps_unfilled, no_gaps_filled_count);
+			files_not_processed_count += files[z].count;
 		}
 	}
 
@@ -686,5 +1552,19 @@ int main(int argc, char *argv[]) {
 						files_not_processed_count
 	);
 
+	/* added on October 18, 2026: datasets that differ make -verify fail */
+	if ( verify ) {
+		i = 0;
+		for ( z = 0; z < files_count; z++ ) {
+			if ( jobs[z].processed && jobs[z].verify_rows ) {
+				++i;
+			}
+		}
+		if ( i ) {
+			printf(msg_verify_failed, i);
+			return 1;
+		}
+	}
+
 	return 0;
 }
@@ -0,0 +1,596 @@
+/*
+	output.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	gap file rows, added on October 18, 2026
+
+	rows are split in chunks of OUTPUT_CHUNK_ROWS. when more threads are
+	used, workers format chunks in parallel into a ring of slots while the
+	calling thread hands them to the writer strictly in order, so the file
+	is the same regardless of the threads count.
+
+	binary files hold the same columns as typed arrays, see output.h
+
+	updated on October 18, 2026: columns can be selected and rows can be
+	limited to the original gaps
+*/
+
+/* includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "output.h"
+#include "format.h"
+
+/* constants */
+#define GAP_ROW_SIZE		(FORMAT_TIMESTAMP_SIZE + OUTPUT_COLUMNS_COUNT*(FORMAT_DOUBLE_SIZE+1) + 1)
+#define SLOTS_PER_THREAD	2
+#define OUTPUT_BYTE_ORDER	0x01020304
+#define OUTPUT_BLOCK_SIZE	(64*1024)
+#define OUTPUT_TIMESTAMP	"TIMESTAMP"
+
+/* extern variables */
+extern int timeres;
+extern char tokens[GF_TOKENS][GF_TOKEN_LENGTH_MAX+1];
+
+/* extern error strings */
+extern const char err_out_of_memory[];
+
+/* error strings */
+static const char err_unknown_column[] = "unknown output column \"%s\".\n\n";
+static const char err_duplicated_column[] = "output column \"%s\" already specified.\n\n";
+static const char err_no_columns[] = "no output columns specified.\n\n";
+static const char err_column_name_too_long[] = "output column name \"%s\" is too long.\n";
+
+/* NULL name means the tofill var */
+static const struct {
+	const char *name;
+	int type;
+} columns[OUTPUT_COLUMNS_COUNT] = {
+	{ NULL, OUTPUT_TYPE_PREC },
+	{ "FILLED", OUTPUT_TYPE_PREC },
+	{ "QC", OUTPUT_TYPE_INT },
+	{ "HAT", OUTPUT_TYPE_PREC },
+	{ "SAMPLE", OUTPUT_TYPE_INT },
+	{ "STDDEV", OUTPUT_TYPE_PREC },
+	{ "METHOD", OUTPUT_TYPE_INT },
+	{ "QC_HAT", OUTPUT_TYPE_INT },
+	{ "TIMEWINDOW", OUTPUT_TYPE_INT },
+};
+
+/* structures */
+typedef struct {
+	char *buffer;
+	int size;
+	int chunk;
+	int ready;
+} SLOT;
+
+typedef struct {
+	const OUTPUT_OPTIONS *options;
+	const ROW *rows;
+	const GF_ROW *gf_rows;
+	const CALENDAR *calendar;
+	int chunks_count;
+	int next;
+	int written;
+	int quit;
+	SLOT *slots;
+	int slots_count;
+	MUTEX mutex;
+	CONDITION condition;
+} OUTPUT;
+
+/* */
+static const char *get_column_name(const OUTPUT_OPTIONS *const options, const int column) {
+	if ( columns[column].name ) {
+		return columns[column].name;
+	}
+	return options->tofill ? options->tofill : tokens[GF_TOFILL];
+}
+
+/* */
+static PREC get_prec_value(const int column, const ROW *const row, const GF_ROW *const gf_row) {
+	switch ( column ) {
+		case OUTPUT_TOFILL:
+			return row->value[GF_TOFILL];
+
+		case OUTPUT_FILLED:
+			return IS_FLAG_SET(gf_row->mask, GF_TOFILL_VALID) ? row->value[GF_TOFILL] : gf_row->filled;
+
+		case OUTPUT_HAT:
+			return gf_row->filled;
+
+		case OUTPUT_STDDEV:
+			return gf_row->stddev;
+	}
+
+	assert(0);
+	return INVALID_VALUE;
+}
+
+/* */
+static int get_int_value(const int column, const GF_ROW *const gf_row) {
+	switch ( column ) {
+		case OUTPUT_QC:
+			return IS_FLAG_SET(gf_row->mask, GF_TOFILL_VALID) ? 0 : gf_row->quality;
+
+		case OUTPUT_SAMPLE:
+			return gf_row->samples_count;
+
+		case OUTPUT_METHOD:
+			return gf_row->method;
+
+		case OUTPUT_QC_HAT:
+			return gf_row->quality;
+
+		case OUTPUT_TIMEWINDOW:
+			return gf_row->time_window;
+	}
+
+	assert(0);
+	return INVALID_VALUE;
+}
+
+/* */
+static int is_gap(const GF_ROW *const gf_row) {
+	return !IS_FLAG_SET(gf_row->mask, GF_TOFILL_VALID);
+}
+
+/* */
+void output_options_default(OUTPUT_OPTIONS *const options) {
+	int i;
+
+	assert(options);
+
+	options->format = OUTPUT_FORMAT_CSV;
+	for ( i = 0; i < OUTPUT_COLUMNS_COUNT; i++ ) {
+		options->columns[i] = i;
+	}
+	options->columns_count = OUTPUT_COLUMNS_COUNT;
+	options->gaps_only = 0;
+	options->threads_count = 1;
+	options->tofill = NULL;
+}
+
+/*
+	list is a comma separated list of column names as in gap file header,
+	timestamp is always written first so it is accepted and skipped.
+	must be called after tokens are assigned. returns 0 on error
+*/
+int output_set_columns(OUTPUT_OPTIONS *const options, const char *const list) {
+	int i;
+	int y;
+	char *p;
+	char *copy;
+	char *token;
+
+	assert(options && list);
+
+	copy = string_copy(list);
+	if ( !copy ) {
+		puts(err_out_of_memory);
+		return 0;
+	}
+
+	options->columns_count = 0;
+	for ( token = string_tokenizer(copy, ",", &p); token; token = string_tokenizer(NULL, ",", &p) ) {
+		if ( !token[0]
+				|| !string_compare_i(token, tokens[GF_ROW_INDEX])
+				|| !string_compare_i(token, OUTPUT_TIMESTAMP) ) {
+			continue;
+		}
+		for ( y = 0; y < OUTPUT_COLUMNS_COUNT; y++ ) {
+			if ( !string_compare_i(token, get_column_name(options, y)) ) {
+				break;
+			}
+		}
+		if ( OUTPUT_COLUMNS_COUNT == y ) {
+			printf(err_unknown_column, token);
+			free(copy);
+			return 0;
+		}
+		for ( i = 0; i < options->columns_count; i++ ) {
+			if ( y == options->columns[i] ) {
+				printf(err_duplicated_column, token);
+				free(copy);
+				return 0;
+			}
+		}
+		options->columns[options->columns_count++] = y;
+	}
+	free(copy);
+
+	if ( !options->columns_count ) {
+		puts(err_no_columns);
+		return 0;
+	}
+
+	return 1;
+}
+
+/* formats selected columns of a row, returns chars written */
+static int format_gap_row(char *p, const OUTPUT_OPTIONS *const options, const TIMESTAMP *const t, const ROW *const row, const GF_ROW *const gf_row) {
+	int i;
+	int y;
+	char *start;
+
+	start = p;
+	p += format_timestamp(p, t);
+	for ( i = 0; i < options->columns_count; i++ ) {
+		*p++ = ',';
+		y = options->columns[i];
+		if ( OUTPUT_TYPE_PREC == columns[y].type ) {
+			p += format_double(p, get_prec_value(y, row, gf_row));
+		} else {
+			p += format_int(p, get_int_value(y, gf_row));
+		}
+	}
+	*p++ = '\n';
+
+	return p - start;
+}
+
+/* formats rows of chunk into buffer, returns chars written */
+static int format_chunk(char *const buffer, const OUTPUT *const output, const int chunk) {
+	int i;
+	int end;
+	char *p;
+	TIMESTAMP_ITERATOR iterator;
+
+	i = chunk * OUTPUT_CHUNK_ROWS;
+	end = i + OUTPUT_CHUNK_ROWS;
+	if ( end > output->calendar->rows_count ) {
+		end = output->calendar->rows_count;
+	}
+
+	timestamp_iterator_init(&iterator, output->calendar, i, 0);
+	for ( p = buffer; i < end; i++, timestamp_iterator_next(&iterator) ) {
+		if ( !output->options->gaps_only || is_gap(&output->gf_rows[i]) ) {
+			p += format_gap_row(p, output->options, &iterator.t, &output->rows[i], &output->gf_rows[i]);
+		}
+	}
+
+	return p - buffer;
+}
+
+/* */
+static void output_thread(void *p) {
+	int chunk;
+	SLOT *slot;
+	OUTPUT *output;
+
+	output = p;
+	mutex_lock(&output->mutex);
+	for ( ; ; ) {
+		/* wait for a free slot */
+		while ( !output->quit
+					&& (output->next < output->chunks_count)
+					&& (output->next - output->written >= output->slots_count) ) {
+			condition_wait(&output->condition, &output->mutex);
+		}
+		if ( output->quit || (output->next >= output->chunks_count) ) {
+			break;
+		}
+		chunk = output->next++;
+		slot = &output->slots[chunk % output->slots_count];
+		mutex_unlock(&output->mutex);
+
+		slot->size = format_chunk(slot->buffer, output, chunk);
+
+		mutex_lock(&output->mutex);
+		slot->chunk = chunk;
+		slot->ready = 1;
+		condition_broadcast(&output->condition);
+	}
+	mutex_unlock(&output->mutex);
+}
+
+/* returns 0 on error */
+static int output_write_serial(WRITER *const writer, const OUTPUT *const output) {
+	int i;
+	int size;
+	char *buffer;
+
+	buffer = malloc(OUTPUT_CHUNK_ROWS*GAP_ROW_SIZE);
+	if ( !buffer ) {
+		return 0;
+	}
+	for ( i = 0; i < output->chunks_count; i++ ) {
+		size = format_chunk(buffer, output, i);
+		if ( !writer_write(writer, buffer, size) ) {
+			break;
+		}
+	}
+	free(buffer);
+
+	return i == output->chunks_count;
+}
+
+/* */
+static void output_free(OUTPUT *const output) {
+	int i;
+
+	if ( output->slots ) {
+		for ( i = 0; i < output->slots_count; i++ ) {
+			free(output->slots[i].buffer);
+		}
+		free(output->slots);
+	}
+	condition_destroy(&output->condition);
+	mutex_destroy(&output->mutex);
+}
+
+/* returns 0 on error */
+static int output_write_csv(WRITER *const writer, const OUTPUT_OPTIONS *const options, const ROW *const rows, const GF_ROW *const gf_rows, const CALENDAR *const calendar) {
+	int i;
+	int ok;
+	int threads_count;
+	int threads_started;
+	SLOT *slot;
+	THREAD *threads;
+	OUTPUT output;
+
+	/* header */
+	ok = writer_write(writer, tokens[GF_ROW_INDEX], strlen(tokens[GF_ROW_INDEX]));
+	for ( i = 0; ok && (i < options->columns_count); i++ ) {
+		ok = writer_write(writer, ",", 1)
+				&& writer_write(writer, get_column_name(options, options->columns[i]), strlen(get_column_name(options, options->columns[i])));
+	}
+	if ( !ok || !writer_write(writer, "\n", 1) ) {
+		return 0;
+	}
+
+	output.options = options;
+	output.rows = rows;
+	output.gf_rows = gf_rows;
+	output.calendar = calendar;
+	output.chunks_count = (calendar->rows_count + OUTPUT_CHUNK_ROWS - 1) / OUTPUT_CHUNK_ROWS;
+	output.next = 0;
+	output.written = 0;
+	output.quit = 0;
+	output.slots = NULL;
+
+	threads_count = options->threads_count;
+	if ( threads_count > output.chunks_count ) {
+		threads_count = output.chunks_count;
+	}
+	if ( threads_count <= 1 ) {
+		return output_write_serial(writer, &output);
+	}
+
+	/* on any failure here just go serial */
+	if ( !mutex_init(&output.mutex) ) {
+		return output_write_serial(writer, &output);
+	}
+	if ( !condition_init(&output.condition) ) {
+		mutex_destroy(&output.mutex);
+		return output_write_serial(writer, &output);
+	}
+	output.slots_count = threads_count * SLOTS_PER_THREAD;
+	output.slots = calloc(output.slots_count, sizeof*output.slots);
+	threads = malloc(threads_count*sizeof*threads);
+	ok = output.slots && threads;
+	for ( i = 0; ok && (i < output.slots_count); i++ ) {
+		output.slots[i].buffer = malloc(OUTPUT_CHUNK_ROWS*GAP_ROW_SIZE);
+		ok = output.slots[i].buffer != NULL;
+	}
+	if ( !ok ) {
+		free(threads);
+		output_free(&output);
+		return output_write_serial(writer, &output);
+	}
+
+	for ( threads_started = 0; threads_started < threads_count; threads_started++ ) {
+		if ( !thread_create(&threads[threads_started], output_thread, &output) ) {
+			break;
+		}
+	}
+
+	/* calling thread writes chunks in order (or formats them too if no thread started) */
+	for ( i = 0; ok && (i < output.chunks_count); i++ ) {
+		slot = &output.slots[i % output.slots_count];
+		if ( !threads_started ) {
+			slot->size = format_chunk(slot->buffer, &output, i);
+		} else {
+			mutex_lock(&output.mutex);
+			while ( !slot->ready || (slot->chunk != i) ) {
+				condition_wait(&output.condition, &output.mutex);
+			}
+			mutex_unlock(&output.mutex);
+		}
+
+		ok = writer_write(writer, slot->buffer, slot->size);
+
+		mutex_lock(&output.mutex);
+		slot->ready = 0;
+		++output.written;
+		if ( !ok ) {
+			output.quit = 1;
+		}
+		condition_broadcast(&output.condition);
+		mutex_unlock(&output.mutex);
+	}
+
+	for ( i = 0; i < threads_started; i++ ) {
+		thread_join(&threads[i]);
+	}
+	free(threads);
+	output_free(&output);
+
+	return ok;
+}
+
+/* */
+static int write_padding(WRITER *const writer, const long long size) {
+	static const char padding[OUTPUT_ALIGN] = { 0 };
+
+	assert((size >= 0) && (size < OUTPUT_ALIGN));
+
+	return !size || writer_write(writer, padding, (int)size);
+}
+
+/* */
+static long long align_size(const long long size) {
+	return (size + OUTPUT_ALIGN - 1) / OUTPUT_ALIGN * OUTPUT_ALIGN;
+}
+
+/* returns 0 on error */
+static int output_write_bin(WRITER *const writer, const OUTPUT_OPTIONS *const options, const ROW *const rows, const GF_ROW *const gf_rows, const CALENDAR *const calendar) {
+	int i;
+	int j;
+	int n;
+	int r;
+	int y;
+	int ok;
+	int column;
+	int rows_count;
+	int columns_count;
+	int *indexes;
+	char *buffer;
+	const char *name;
+	long long offset;
+	TIMESTAMP t;
+	OUTPUT_HEADER header;
+	OUTPUT_COLUMN directory[OUTPUT_COLUMNS_COUNT+1];
+
+	/* rows to write, NULL indexes means all of them */
+	indexes = NULL;
+	rows_count = calendar->rows_count;
+	if ( options->gaps_only ) {
+		indexes = malloc(calendar->rows_count*sizeof*indexes);
+		if ( !indexes ) {
+			puts(err_out_of_memory);
+			return 0;
+		}
+		for ( rows_count = 0, i = 0; i < calendar->rows_count; i++ ) {
+			if ( is_gap(&gf_rows[i]) ) {
+				indexes[rows_count++] = i;
+			}
+		}
+	}
+	columns_count = options->columns_count + (indexes ? 1 : 0);
+
+	/* set header */
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, OUTPUT_MAGIC, sizeof(OUTPUT_MAGIC));
+	header.version = OUTPUT_VERSION;
+	header.byte_order = OUTPUT_BYTE_ORDER;
+	header.prec_size = sizeof(PREC);
+	header.timeres = timeres;
+	format_timestamp(header.timestamp, calendar_end_by_row_r(calendar, 0, &t));
+	header.start = calendar->start;
+	header.step = calendar->step;
+	header.rows_count = rows_count;
+	header.columns_count = columns_count;
+
+	/* set columns, -1 is the row index */
+	memset(directory, 0, sizeof(directory));
+	offset = align_size(sizeof(header) + columns_count*sizeof(OUTPUT_COLUMN));
+	for ( y = 0; y < columns_count; y++ ) {
+		column = indexes ? y - 1 : y;
+		if ( column < 0 ) {
+			strcpy(directory[y].name, OUTPUT_ROW_NAME);
+			directory[y].type = OUTPUT_TYPE_INT;
+		} else {
+			column = options->columns[column];
+			name = get_column_name(options, column);
+			n = (int)strlen(name);
+			if ( n > OUTPUT_NAME_LENGTH ) {
+				printf(err_column_name_too_long, name);
+				free(indexes);
+				return 0;
+			}
+			memcpy(directory[y].name, name, n);
+			directory[y].name[n] = '\0';
+			directory[y].type = columns[column].type;
+		}
+		directory[y].size = (OUTPUT_TYPE_PREC == directory[y].type) ? sizeof(PREC) : sizeof(int);
+		directory[y].offset = offset;
+		offset = align_size(offset + (long long)rows_count*directory[y].size);
+	}
+
+	buffer = malloc(OUTPUT_BLOCK_SIZE);
+	if ( !buffer ) {
+		puts(err_out_of_memory);
+		free(indexes);
+		return 0;
+	}
+
+	ok = writer_write(writer, (const char *)&header, sizeof(header))
+			&& writer_write(writer, (const char *)directory, columns_count*sizeof(OUTPUT_COLUMN));
+	offset = sizeof(header) + columns_count*sizeof(OUTPUT_COLUMN);
+
+	/* write columns, each one starting at an aligned offset */
+	for ( y = 0; ok && (y < columns_count); y++ ) {
+		column = indexes ? y - 1 : y;
+		if ( column >= 0 ) {
+			column = options->columns[column];
+		}
+		ok = write_padding(writer, directory[y].offset - offset);
+		for ( i = 0; ok && (i < rows_count); i += n ) {
+			n = OUTPUT_BLOCK_SIZE / directory[y].size;
+			if ( n > rows_count - i ) {
+				n = rows_count - i;
+			}
+			for ( j = 0; j < n; j++ ) {
+				r = indexes ? indexes[i+j] : i+j;
+				if ( column < 0 ) {
+					((int *)buffer)[j] = r;
+				} else if ( OUTPUT_TYPE_PREC == columns[column].type ) {
+					((PREC *)buffer)[j] = get_prec_value(column, &rows[r], &gf_rows[r]);
+				} else {
+					((int *)buffer)[j] = get_int_value(column, &gf_rows[r]);
+				}
+			}
+			ok = writer_write(writer, buffer, n*directory[y].size);
+		}
+		offset = directory[y].offset + (long long)rows_count*directory[y].size;
+	}
+	if ( ok ) {
+		ok = write_padding(writer, align_size(offset) - offset);
+	}
+	free(buffer);
+	free(indexes);
+
+	return ok;
+}
+
+/* returns 0 on error */
+int output_write(WRITER *const writer, const OUTPUT_OPTIONS *const options, const ROW *const rows, const GF_ROW *const gf_rows, const CALENDAR *const calendar) {
+	assert(writer && options && rows && gf_rows && calendar);
+
+	if ( OUTPUT_FORMAT_BIN == options->format ) {
+		return output_write_bin(writer, options, rows, gf_rows, calendar);
+	}
+
+	return output_write_csv(writer, options, rows, gf_rows, calendar);
+}
+
+/* */
+const char *get_output_format_extension(const int format) {
+	return (OUTPUT_FORMAT_BIN == format) ? ".gfo" : ".csv";
+}
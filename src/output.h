@@ -0,0 +1,113 @@
+/*
+	output.h
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+/* includes */
+#include "types.h"
+#include "writer.h"
+
+/* constants */
+#define OUTPUT_CHUNK_ROWS		8192
+#define OUTPUT_MAGIC			"GFO"
+#define OUTPUT_VERSION			1
+#define OUTPUT_ALIGN			64
+#define OUTPUT_NAME_LENGTH		31
+#define OUTPUT_ROW_NAME			"ROW"
+
+/* */
+enum {
+	OUTPUT_FORMAT_CSV = 0,
+	OUTPUT_FORMAT_BIN,
+
+	OUTPUT_FORMATS_COUNT
+};
+
+/* must have same order of columns in gap file */
+enum {
+	OUTPUT_TOFILL = 0,
+	OUTPUT_FILLED,
+	OUTPUT_QC,
+	OUTPUT_HAT,
+	OUTPUT_SAMPLE,
+	OUTPUT_STDDEV,
+	OUTPUT_METHOD,
+	OUTPUT_QC_HAT,
+	OUTPUT_TIMEWINDOW,
+
+	OUTPUT_COLUMNS_COUNT
+};
+
+/* */
+enum {
+	OUTPUT_TYPE_PREC = 0,
+	OUTPUT_TYPE_INT,
+};
+
+/*
+	gfo file layout: OUTPUT_HEADER, columns_count OUTPUT_COLUMN, then
+	the columns of rows_count values, each one starting at an OUTPUT_ALIGN
+	boundary. row i has end timestamp start + i * step minutes since epoch.
+	when only gaps are written the first column is OUTPUT_ROW_NAME and
+	holds the row index of each value
+*/
+typedef struct {
+	char magic[4];
+	int version;
+	int byte_order;
+	int prec_size;
+	int timeres;
+	char timestamp[12+1+3];		/* YYYYMMDDhhmm of the first row end */
+	int start;
+	int step;
+	int rows_count;
+	int columns_count;
+	int reserved;				/* keeps OUTPUT_COLUMN 8 bytes aligned */
+} OUTPUT_HEADER;
+
+typedef struct {
+	char name[OUTPUT_NAME_LENGTH+1];
+	int type;
+	int size;
+	long long offset;
+} OUTPUT_COLUMN;
+
+typedef struct {
+	int format;
+	int columns[OUTPUT_COLUMNS_COUNT];
+	int columns_count;
+	int gaps_only;
+	int threads_count;
+	const char *tofill;			/* name of OUTPUT_TOFILL, NULL means tokens[GF_TOFILL] */
+} OUTPUT_OPTIONS;
+
+/* prototypes */
+void output_options_default(OUTPUT_OPTIONS *const options);
+int output_set_columns(OUTPUT_OPTIONS *const options, const char *const list);
+int output_write(WRITER *const writer, const OUTPUT_OPTIONS *const options, const ROW *const rows, const GF_ROW *const gf_rows, const CALENDAR *const calendar);
+const char *get_output_format_extension(const int format);
+
+#endif /* OUTPUT_H */
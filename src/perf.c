@@ -0,0 +1,128 @@
+/*
+	perf.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* includes */
+#include <string.h>
+#include <assert.h>
+#include "perf.h"
+#if defined (HAVE_PERF_EVENT)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* */
+static const char *const names[PERF_COUNTERS] = {
+	"cycles",
+	"instructions",
+	"cache_misses",
+	"branch_misses",
+};
+
+#if defined (HAVE_PERF_EVENT)
+/* */
+static const unsigned long long configs[PERF_COUNTERS] = {
+	PERF_COUNT_HW_CPU_CYCLES,
+	PERF_COUNT_HW_INSTRUCTIONS,
+	PERF_COUNT_HW_CACHE_MISSES,
+	PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+/* counter of calling thread on any cpu, returns -1 on error */
+static int open_counter(const unsigned long long config) {
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof attr);
+	attr.size = sizeof attr;
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = config;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	/* counters are multiplexed if they are more than the pmu has */
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+/* starts counting, returns mask of counters opened (0 if none) */
+int perf_start(PERF *const perf) {
+	int i;
+	int mask;
+
+	assert(perf);
+
+	mask = 0;
+	for ( i = 0; i < PERF_COUNTERS; i++ ) {
+#if defined (HAVE_PERF_EVENT)
+		perf->fd[i] = open_counter(configs[i]);
+#else
+		perf->fd[i] = -1;
+#endif
+		if ( perf->fd[i] != -1 ) {
+			mask |= 1 << i;
+		}
+	}
+
+	return mask;
+}
+
+/*
+	stops counting and adds counts to values, scaled if multiplexed.
+	returns mask of counters read
+*/
+int perf_stop(PERF *const perf, double *const values) {
+	int i;
+	int mask;
+#if defined (HAVE_PERF_EVENT)
+	unsigned long long buffer[3];	/* value, time enabled, time running */
+#endif
+
+	assert(perf && values);
+
+	mask = 0;
+	for ( i = 0; i < PERF_COUNTERS; i++ ) {
+		if ( -1 == perf->fd[i] ) {
+			continue;
+		}
+#if defined (HAVE_PERF_EVENT)
+		if ( (sizeof buffer == read(perf->fd[i], buffer, sizeof buffer)) && buffer[2] ) {
+			values[i] += (double)buffer[0] * ((double)buffer[1] / buffer[2]);
+			mask |= 1 << i;
+		}
+		close(perf->fd[i]);
+#endif
+		perf->fd[i] = -1;
+	}
+
+	return mask;
+}
+
+/* */
+const char *perf_get_counter_name(const int counter) {
+	assert((counter >= 0) && (counter < PERF_COUNTERS));
+
+	return names[counter];
+}
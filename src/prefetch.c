@@ -0,0 +1,572 @@
+/*
+	prefetch.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	input prefetch, added on October 18, 2026
+
+	a thread reads whole input files ahead of the parser, PREFETCH_BATCH
+	files at a time, and keeps them in memory until import_dataset takes
+	them. on linux the files of a batch are read with a single io_uring
+	submission (raw syscalls, no liburing needed), everywhere else or if
+	io_uring is not available plain reads are used.
+
+	files are identified by the address of their name as passed to
+	prefetch_open, so the same file listed twice is read twice.
+	a file that is not ready when asked is simply read by the caller.
+	compressed files are left to the reader.
+*/
+
+/* includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include "prefetch.h"
+#include "reader.h"
+#include "common.h"
+
+#ifdef HAVE_IO_URING
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+/* structures */
+typedef struct {
+	int fd;
+	unsigned *sq_head;
+	unsigned *sq_tail;
+	unsigned *sq_mask;
+	unsigned *sq_array;
+	unsigned *cq_head;
+	unsigned *cq_tail;
+	unsigned *cq_mask;
+	struct io_uring_sqe *sqes;
+	struct io_uring_cqe *cqes;
+	void *sq_ptr;
+	size_t sq_size;
+	void *cq_ptr;
+	size_t cq_size;
+	size_t sqes_size;
+} URING;
+
+typedef struct {
+	int fd;
+	int done;
+	struct iovec iov;
+} URING_READ;
+
+/* */
+static void uring_close(URING *const ring) {
+	if ( ring->sqes ) {
+		munmap(ring->sqes, ring->sqes_size);
+	}
+	if ( ring->cq_ptr && (ring->cq_ptr != ring->sq_ptr) ) {
+		munmap(ring->cq_ptr, ring->cq_size);
+	}
+	if ( ring->sq_ptr ) {
+		munmap(ring->sq_ptr, ring->sq_size);
+	}
+	if ( ring->fd >= 0 ) {
+		close(ring->fd);
+	}
+	memset(ring, 0, sizeof*ring);
+	ring->fd = -1;
+}
+
+/* returns 0 if io_uring is not available */
+static int uring_init(URING *const ring, const unsigned entries) {
+	struct io_uring_params params;
+
+	memset(ring, 0, sizeof*ring);
+	memset(&params, 0, sizeof(params));
+	ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+	if ( ring->fd < 0 ) {
+		ring->fd = -1;
+		return 0;
+	}
+
+	ring->sq_size = params.sq_off.array + params.sq_entries*sizeof(unsigned);
+	ring->cq_size = params.cq_off.cqes + params.cq_entries*sizeof(struct io_uring_cqe);
+#ifdef IORING_FEAT_SINGLE_MMAP
+	if ( params.features & IORING_FEAT_SINGLE_MMAP ) {
+		if ( ring->cq_size > ring->sq_size ) {
+			ring->sq_size = ring->cq_size;
+		}
+		ring->cq_size = ring->sq_size;
+	}
+#endif
+	ring->sq_ptr = mmap(NULL, ring->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+	if ( MAP_FAILED == ring->sq_ptr ) {
+		ring->sq_ptr = NULL;
+		uring_close(ring);
+		return 0;
+	}
+#ifdef IORING_FEAT_SINGLE_MMAP
+	if ( params.features & IORING_FEAT_SINGLE_MMAP ) {
+		ring->cq_ptr = ring->sq_ptr;
+	} else
+#endif
+	{
+		ring->cq_ptr = mmap(NULL, ring->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+		if ( MAP_FAILED == ring->cq_ptr ) {
+			ring->cq_ptr = NULL;
+			uring_close(ring);
+			return 0;
+		}
+	}
+	ring->sqes_size = params.sq_entries*sizeof(struct io_uring_sqe);
+	ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+	if ( MAP_FAILED == ring->sqes ) {
+		ring->sqes = NULL;
+		uring_close(ring);
+		return 0;
+	}
+
+	ring->sq_head = (unsigned *)((char *)ring->sq_ptr + params.sq_off.head);
+	ring->sq_tail = (unsigned *)((char *)ring->sq_ptr + params.sq_off.tail);
+	ring->sq_mask = (unsigned *)((char *)ring->sq_ptr + params.sq_off.ring_mask);
+	ring->sq_array = (unsigned *)((char *)ring->sq_ptr + params.sq_off.array);
+	ring->cq_head = (unsigned *)((char *)ring->cq_ptr + params.cq_off.head);
+	ring->cq_tail = (unsigned *)((char *)ring->cq_ptr + params.cq_off.tail);
+	ring->cq_mask = (unsigned *)((char *)ring->cq_ptr + params.cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe *)((char *)ring->cq_ptr + params.cq_off.cqes);
+
+	return 1;
+}
+
+/* queues a readv of what is left of r, index is returned in the completion */
+static void uring_queue_read(URING *const ring, URING_READ *const r, const int size, const int index) {
+	unsigned tail;
+	unsigned i;
+	struct io_uring_sqe *sqe;
+
+	r->iov.iov_len = size - r->done;
+
+	tail = *ring->sq_tail;
+	i = tail & *ring->sq_mask;
+	sqe = &ring->sqes[i];
+	memset(sqe, 0, sizeof*sqe);
+	sqe->opcode = IORING_OP_READV;
+	sqe->fd = r->fd;
+	sqe->addr = (unsigned long)&r->iov;
+	sqe->len = 1;
+	sqe->off = r->done;
+	sqe->user_data = index;
+	ring->sq_array[i] = i;
+	__atomic_store_n(ring->sq_tail, tail+1, __ATOMIC_RELEASE);
+}
+
+/* waits for inflight reads, returns 0 if the ring failed before all of them completed */
+static int uring_wait(URING *const ring, int inflight) {
+	unsigned head;
+	unsigned tail;
+
+	while ( inflight > 0 ) {
+		if ( syscall(__NR_io_uring_enter, ring->fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0 ) {
+			if ( EINTR == errno ) {
+				continue;
+			}
+			return 0;
+		}
+		head = *ring->cq_head;
+		tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+		inflight -= (int)(tail - head);
+		__atomic_store_n(ring->cq_head, tail, __ATOMIC_RELEASE);
+	}
+
+	return 1;
+}
+
+/*
+	reads batch files, returns 0 if ring failed.
+	on failure ring is closed and files not completed have NULL buffer
+*/
+static int uring_load(URING *const ring, PREFETCH_FILE *const *const batch, const int count) {
+	int i;
+	int ret;
+	int pending;
+	int submit;
+	int inflight;
+	unsigned head;
+	unsigned tail;
+	struct stat st;
+	struct io_uring_cqe *cqe;
+	URING_READ reads[PREFETCH_BATCH];
+
+	assert(count <= PREFETCH_BATCH);
+
+	/* open files and queue a read for each one */
+	pending = 0;
+	for ( i = 0; i < count; i++ ) {
+		reads[i].done = 0;
+		reads[i].fd = open(batch[i]->filename, O_RDONLY);
+		if ( (reads[i].fd < 0) || fstat(reads[i].fd, &st) || (st.st_size > INT_MAX) ) {
+			continue;
+		}
+		batch[i]->size = (int)st.st_size;
+		batch[i]->buffer = malloc(batch[i]->size ? batch[i]->size : 1);
+		if ( !batch[i]->buffer || !batch[i]->size ) {
+			continue;
+		}
+		reads[i].iov.iov_base = batch[i]->buffer;
+		uring_queue_read(ring, &reads[i], batch[i]->size, i);
+		++pending;
+	}
+
+	/*
+		submit and reap until every read is complete.
+		submit counts sqes queued but not yet taken by the kernel,
+		inflight the ones taken and not yet completed
+	*/
+	inflight = 0;
+	for ( submit = pending; pending; ) {
+		ret = (int)syscall(__NR_io_uring_enter, ring->fd, submit, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+		if ( ret < 0 ) {
+			if ( EINTR == errno ) {
+				continue;
+			}
+			break;
+		}
+		if ( !ret && submit && !inflight ) {
+			/* nothing taken and nothing to wait for, give up */
+			break;
+		}
+		submit -= ret;
+		inflight += ret;
+
+		head = *ring->cq_head;
+		tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+		for ( ; head != tail; head++ ) {
+			cqe = &ring->cqes[head & *ring->cq_mask];
+			i = (int)cqe->user_data;
+			--inflight;
+			if ( cqe->res <= 0 ) {
+				/* error or unexpected end of file, let the reader handle it */
+				free(batch[i]->buffer);
+				batch[i]->buffer = NULL;
+				--pending;
+			} else {
+				reads[i].done += cqe->res;
+				reads[i].iov.iov_base = batch[i]->buffer + reads[i].done;
+				if ( reads[i].done < batch[i]->size ) {
+					uring_queue_read(ring, &reads[i], batch[i]->size, i);
+					++submit;
+				} else {
+					--pending;
+				}
+			}
+		}
+		__atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+	}
+
+	if ( pending ) {
+		/*
+			kernel may still write into buffers of inflight reads:
+			wait for them and close ring before buffers and reads
+			go away, sqes never taken are dropped with the ring.
+			if waiting fails too, buffers not completed are leaked
+			rather than freed under the kernel
+		*/
+		ret = uring_wait(ring, inflight);
+		uring_close(ring);
+		for ( i = 0; i < count; i++ ) {
+			if ( batch[i]->buffer && (reads[i].done < batch[i]->size) ) {
+				if ( ret ) {
+					free(batch[i]->buffer);
+				}
+				batch[i]->buffer = NULL;
+			}
+		}
+	}
+
+	for ( i = 0; i < count; i++ ) {
+		if ( reads[i].fd >= 0 ) {
+			close(reads[i].fd);
+		}
+	}
+
+	return !pending;
+}
+#endif /* HAVE_IO_URING */
+
+/* files already loaded are skipped */
+static void plain_load(PREFETCH_FILE *const *const batch, const int count) {
+	int i;
+	long long size;
+	FILE *f;
+
+	for ( i = 0; i < count; i++ ) {
+		if ( batch[i]->buffer ) {
+			continue;
+		}
+		size = get_file_size(batch[i]->filename);
+		if ( (size < 0) || (size > INT_MAX) ) {
+			continue;
+		}
+		batch[i]->size = (int)size;
+		batch[i]->buffer = malloc(size ? (size_t)size : 1);
+		if ( !batch[i]->buffer ) {
+			continue;
+		}
+		f = fopen(batch[i]->filename, "rb");
+		if ( !f || ((size_t)size != fread(batch[i]->buffer, 1, (size_t)size, f)) ) {
+			free(batch[i]->buffer);
+			batch[i]->buffer = NULL;
+		}
+		if ( f ) {
+			fclose(f);
+		}
+	}
+}
+
+/* */
+static void prefetch_thread(void *p) {
+	int i;
+	int n;
+	PREFETCH *prefetch;
+	PREFETCH_FILE *f;
+	PREFETCH_FILE *batch[PREFETCH_BATCH];
+#ifdef HAVE_IO_URING
+	URING ring;
+
+	prefetch = p;
+	prefetch->uring = uring_init(&ring, PREFETCH_BATCH);
+#else
+	prefetch = p;
+#endif
+
+	mutex_lock(&prefetch->mutex);
+	for ( ; ; ) {
+		/* wait for room */
+		while ( !prefetch->quit
+					&& (prefetch->next < prefetch->count)
+					&& ((prefetch->ready_count >= PREFETCH_FILES_MAX) || (prefetch->ready_bytes >= PREFETCH_BYTES_MAX)) ) {
+			condition_wait(&prefetch->condition, &prefetch->mutex);
+		}
+		if ( prefetch->quit || (prefetch->next >= prefetch->count) ) {
+			break;
+		}
+
+		/* files already asked or discarded are skipped */
+		for ( n = 0; (n < PREFETCH_BATCH)
+						&& (prefetch->next < prefetch->count)
+						&& (prefetch->ready_count + n < PREFETCH_FILES_MAX); prefetch->next++ ) {
+			f = &prefetch->files[prefetch->next];
+			if ( PREFETCH_PENDING == f->state ) {
+				f->state = PREFETCH_LOADING;
+				batch[n++] = f;
+			}
+		}
+		mutex_unlock(&prefetch->mutex);
+
+#ifdef HAVE_IO_URING
+		if ( prefetch->uring && !uring_load(&ring, batch, n) ) {
+			prefetch->uring = 0;
+		}
+		if ( !prefetch->uring ) {
+			plain_load(batch, n);
+		}
+#else
+		plain_load(batch, n);
+#endif
+
+		/* check compression */
+		for ( i = 0; i < n; i++ ) {
+			if ( batch[i]->buffer
+					&& (COMPRESSION_NONE != get_compression_by_magic(batch[i]->buffer, batch[i]->size)) ) {
+				free(batch[i]->buffer);
+				batch[i]->buffer = NULL;
+			}
+		}
+
+		mutex_lock(&prefetch->mutex);
+		for ( i = 0; i < n; i++ ) {
+			if ( batch[i]->buffer && (PREFETCH_LOADING == batch[i]->state) ) {
+				batch[i]->state = PREFETCH_READY;
+				++prefetch->ready_count;
+				prefetch->ready_bytes += batch[i]->size;
+			} else {
+				/* failed or discarded while loading */
+				free(batch[i]->buffer);
+				batch[i]->buffer = NULL;
+				batch[i]->state = PREFETCH_SKIPPED;
+			}
+		}
+		condition_broadcast(&prefetch->condition);
+	}
+	mutex_unlock(&prefetch->mutex);
+
+#ifdef HAVE_IO_URING
+	if ( prefetch->uring ) {
+		uring_close(&ring);
+	}
+#endif
+}
+
+/*
+	filenames must stay valid until prefetch_close.
+	returns NULL on error
+*/
+PREFETCH *prefetch_open(const char *const *const filenames, const int count) {
+	int i;
+	PREFETCH *prefetch;
+
+	assert(filenames && (count > 0));
+
+	prefetch = malloc(sizeof*prefetch);
+	if ( !prefetch ) {
+		return NULL;
+	}
+	memset(prefetch, 0, sizeof*prefetch);
+	prefetch->files = calloc(count, sizeof*prefetch->files);
+	if ( !prefetch->files ) {
+		free(prefetch);
+		return NULL;
+	}
+	for ( i = 0; i < count; i++ ) {
+		prefetch->files[i].filename = filenames[i];
+	}
+	prefetch->count = count;
+	if ( !mutex_init(&prefetch->mutex) ) {
+		free(prefetch->files);
+		free(prefetch);
+		return NULL;
+	}
+	if ( !condition_init(&prefetch->condition) ) {
+		mutex_destroy(&prefetch->mutex);
+		free(prefetch->files);
+		free(prefetch);
+		return NULL;
+	}
+	if ( !thread_create(&prefetch->thread, prefetch_thread, prefetch) ) {
+		condition_destroy(&prefetch->condition);
+		mutex_destroy(&prefetch->mutex);
+		free(prefetch->files);
+		free(prefetch);
+		return NULL;
+	}
+
+	return prefetch;
+}
+
+/* must be called with mutex locked, returns NULL if not found */
+static PREFETCH_FILE *prefetch_find(PREFETCH *const prefetch, const char *const filename) {
+	int i;
+	int y;
+
+	for ( y = 0; y < prefetch->count; y++ ) {
+		i = (prefetch->hint + y) % prefetch->count;
+		if ( prefetch->files[i].filename == filename ) {
+			prefetch->hint = i + 1;
+			return &prefetch->files[i];
+		}
+	}
+
+	return NULL;
+}
+
+/*
+	on success buffer belongs to the caller (see reader_open_buffer).
+	returns 0 if file must be read by the caller
+*/
+int prefetch_take(PREFETCH *const prefetch, const char *const filename, char **const buffer, int *const size) {
+	int ok;
+	PREFETCH_FILE *f;
+
+	assert(prefetch && filename && buffer && size);
+
+	ok = 0;
+	mutex_lock(&prefetch->mutex);
+	f = prefetch_find(prefetch, filename);
+	if ( f ) {
+		while ( PREFETCH_LOADING == f->state ) {
+			condition_wait(&prefetch->condition, &prefetch->mutex);
+		}
+		if ( PREFETCH_READY == f->state ) {
+			*buffer = f->buffer;
+			*size = f->size;
+			f->buffer = NULL;
+			--prefetch->ready_count;
+			prefetch->ready_bytes -= f->size;
+			ok = 1;
+		}
+		/* not yet started files are not read anymore */
+		f->state = PREFETCH_SKIPPED;
+		condition_broadcast(&prefetch->condition);
+	}
+	mutex_unlock(&prefetch->mutex);
+
+	return ok;
+}
+
+/* file will not be asked, frees it or prevents its read */
+void prefetch_discard(PREFETCH *const prefetch, const char *const filename) {
+	PREFETCH_FILE *f;
+
+	assert(prefetch && filename);
+
+	mutex_lock(&prefetch->mutex);
+	f = prefetch_find(prefetch, filename);
+	if ( f && (PREFETCH_SKIPPED != f->state) ) {
+		if ( PREFETCH_READY == f->state ) {
+			free(f->buffer);
+			f->buffer = NULL;
+			--prefetch->ready_count;
+			prefetch->ready_bytes -= f->size;
+		}
+		f->state = PREFETCH_SKIPPED;
+		condition_broadcast(&prefetch->condition);
+	}
+	mutex_unlock(&prefetch->mutex);
+}
+
+/* */
+void prefetch_close(PREFETCH *prefetch) {
+	int i;
+
+	if ( !prefetch ) {
+		return;
+	}
+
+	mutex_lock(&prefetch->mutex);
+	prefetch->quit = 1;
+	condition_broadcast(&prefetch->condition);
+	mutex_unlock(&prefetch->mutex);
+	thread_join(&prefetch->thread);
+
+	for ( i = 0; i < prefetch->count; i++ ) {
+		free(prefetch->files[i].buffer);
+	}
+	condition_destroy(&prefetch->condition);
+	mutex_destroy(&prefetch->mutex);
+	free(prefetch->files);
+	free(prefetch);
+}
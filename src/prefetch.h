@@ -0,0 +1,73 @@
+/*
+	prefetch.h
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+/* includes */
+#include "thread.h"
+
+/* constants */
+#define PREFETCH_BATCH			16					/* files read with a single submission */
+#define PREFETCH_FILES_MAX		64					/* files kept in memory waiting to be parsed */
+#define PREFETCH_BYTES_MAX		(256*1024*1024)		/* bytes kept in memory waiting to be parsed */
+
+/* file states */
+enum {
+	PREFETCH_PENDING = 0,
+	PREFETCH_LOADING,
+	PREFETCH_READY,
+	PREFETCH_SKIPPED,
+};
+
+/* structures */
+typedef struct {
+	const char *filename;
+	char *buffer;
+	int size;
+	int state;
+} PREFETCH_FILE;
+
+typedef struct {
+	PREFETCH_FILE *files;
+	int count;
+	int next;
+	int hint;
+	int ready_count;
+	long long ready_bytes;
+	int quit;
+	int uring;
+	THREAD thread;
+	MUTEX mutex;
+	CONDITION condition;
+} PREFETCH;
+
+/* prototypes */
+PREFETCH *prefetch_open(const char *const *const filenames, const int count);
+int prefetch_take(PREFETCH *const prefetch, const char *const filename, char **const buffer, int *const size);
+void prefetch_discard(PREFETCH *const prefetch, const char *const filename);
+void prefetch_close(PREFETCH *prefetch);
+
+#endif /* PREFETCH_H */
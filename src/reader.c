@@ -0,0 +1,435 @@
+/*
+	reader.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	streaming reader, added on October 18, 2026
+
+	lines are never copied: the file is read in big chunks and fields are
+	scanned in place, so lines can be of any length. only fields asked with
+	a destination buffer are copied, other ones are just skipped.
+*/
+
+/* includes */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "reader.h"
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+/* constants */
+#define GZIP_MAGIC		"\x1f\x8b"
+#define ZSTD_MAGIC		"\x28\xb5\x2f\xfd"
+
+/* char types */
+enum {
+	READER_CHAR = 0,
+	READER_DELIMITER,
+	READER_EOL,
+};
+
+#ifdef HAVE_ZSTD
+/* */
+static int reader_fill_zstd(READER *const reader) {
+	size_t n;
+	ZSTD_inBuffer *in;
+	ZSTD_outBuffer out;
+
+	in = reader->in;
+	out.dst = reader->buffer;
+	out.size = reader->size;
+	out.pos = 0;
+	while ( !out.pos ) {
+		if ( in->pos == in->size ) {
+			in->size = fread((void *)in->src, 1, ZSTD_DStreamInSize(), reader->f);
+			in->pos = 0;
+			if ( !in->size ) {
+				/* file ends in the middle of a frame */
+				if ( reader->frame_open || ferror(reader->f) ) {
+					reader->error = 1;
+				}
+				break;
+			}
+		}
+		n = ZSTD_decompressStream(reader->handle, &out, in);
+		if ( ZSTD_isError(n) ) {
+			reader->error = 1;
+			break;
+		}
+		reader->frame_open = (0 != n);
+	}
+
+	return (int)out.pos;
+}
+#endif
+
+/* */
+static int reader_fill(READER *const reader) {
+#ifdef HAVE_ZLIB
+	int errnum;
+#endif
+
+	reader->pos = 0;
+	switch ( reader->compression ) {
+#ifdef HAVE_ZLIB
+		case COMPRESSION_GZIP:
+			reader->len = gzread(reader->handle, reader->buffer, reader->size);
+			if ( reader->len <= 0 ) {
+				/* a truncated file ends with Z_BUF_ERROR, not with -1 */
+				gzerror(reader->handle, &errnum);
+				if ( (reader->len < 0) || (Z_OK != errnum) ) {
+					reader->error = 1;
+				}
+				reader->len = 0;
+			}
+		break;
+#endif
+
+#ifdef HAVE_ZSTD
+		case COMPRESSION_ZSTD:
+			reader->len = reader_fill_zstd(reader);
+		break;
+#endif
+
+		default:
+			/* a reader opened on a buffer has nothing more to read */
+			if ( !reader->f ) {
+				reader->len = 0;
+				break;
+			}
+			reader->len = (int)fread(reader->buffer, 1, reader->size, reader->f);
+			if ( ferror(reader->f) ) {
+				reader->error = 1;
+			}
+	}
+	return reader->len > 0;
+}
+
+/* added on October 18, 2026 */
+int is_compression_supported(const int compression) {
+	switch ( compression ) {
+		case COMPRESSION_NONE:
+			return 1;
+#ifdef HAVE_ZLIB
+		case COMPRESSION_GZIP:
+			return 1;
+#endif
+#ifdef HAVE_ZSTD
+		case COMPRESSION_ZSTD:
+			return 1;
+#endif
+	}
+	return 0;
+}
+
+/* added on October 18, 2026: n is the number of bytes available at magic */
+int get_compression_by_magic(const char *const magic, const int n) {
+	if ( (n >= (int)sizeof(GZIP_MAGIC)-1) && !memcmp(magic, GZIP_MAGIC, sizeof(GZIP_MAGIC)-1) ) {
+		return COMPRESSION_GZIP;
+	} else if ( (n >= (int)sizeof(ZSTD_MAGIC)-1) && !memcmp(magic, ZSTD_MAGIC, sizeof(ZSTD_MAGIC)-1) ) {
+		return COMPRESSION_ZSTD;
+	}
+
+	return COMPRESSION_NONE;
+}
+
+/* */
+static int get_compression(FILE *const f) {
+	int n;
+	char magic[4];
+
+	n = (int)fread(magic, 1, sizeof(magic), f);
+	rewind(f);
+
+	return get_compression_by_magic(magic, n);
+}
+
+/* */
+static int reader_open_stream(READER *const reader, const char *const filename) {
+	reader->f = fopen(filename, "rb");
+	if ( !reader->f ) {
+		return 0;
+	}
+
+	reader->compression = get_compression(reader->f);
+	if ( !is_compression_supported(reader->compression) ) {
+		return 0;
+	}
+
+	switch ( reader->compression ) {
+#ifdef HAVE_ZLIB
+		case COMPRESSION_GZIP:
+			fclose(reader->f);
+			reader->f = NULL;
+			reader->handle = gzopen(filename, "rb");
+			if ( !reader->handle ) {
+				return 0;
+			}
+			gzbuffer(reader->handle, READER_BUFFER_SIZE);
+		break;
+#endif
+
+#ifdef HAVE_ZSTD
+		case COMPRESSION_ZSTD:
+			reader->handle = ZSTD_createDCtx();
+			reader->in = malloc(sizeof(ZSTD_inBuffer) + ZSTD_DStreamInSize());
+			if ( !reader->handle || !reader->in ) {
+				return 0;
+			}
+			((ZSTD_inBuffer *)reader->in)->src = (char *)reader->in + sizeof(ZSTD_inBuffer);
+			((ZSTD_inBuffer *)reader->in)->size = 0;
+			((ZSTD_inBuffer *)reader->in)->pos = 0;
+		break;
+#endif
+	}
+
+	return 1;
+}
+
+/* */
+static void reader_set_delimiters(READER *const reader, const char *const delimiters) {
+	int i;
+
+	for ( i = 0; delimiters[i]; i++ ) {
+		reader->type[(unsigned char)delimiters[i]] = READER_DELIMITER;
+	}
+	reader->type['\r'] = READER_EOL;
+	reader->type['\n'] = READER_EOL;
+}
+
+/* */
+READER *reader_open(const char *const filename, const char *const delimiters) {
+	READER *reader;
+
+	assert(filename && delimiters);
+
+	reader = malloc(sizeof*reader);
+	if ( !reader ) {
+		return NULL;
+	}
+	memset(reader, 0, sizeof*reader);
+
+	reader->size = READER_BUFFER_SIZE;
+	reader->buffer = malloc(reader->size*sizeof*reader->buffer);
+	if ( !reader->buffer || !reader_open_stream(reader, filename) ) {
+		reader_close(reader);
+		return NULL;
+	}
+
+	/* set char types */
+	reader_set_delimiters(reader, delimiters);
+
+	return reader;
+}
+
+/*
+	added on October 18, 2026
+
+	reads an uncompressed file already in memory, buffer must be
+	allocated with malloc and is freed by reader_close
+*/
+READER *reader_open_buffer(char *const buffer, const int size, const char *const delimiters) {
+	READER *reader;
+
+	assert(buffer && (size >= 0) && delimiters);
+
+	reader = malloc(sizeof*reader);
+	if ( !reader ) {
+		return NULL;
+	}
+	memset(reader, 0, sizeof*reader);
+
+	reader->compression = COMPRESSION_NONE;
+	reader->buffer = buffer;
+	reader->size = size;
+	reader->len = size;
+	reader_set_delimiters(reader, delimiters);
+
+	return reader;
+}
+
+/* */
+void reader_close(READER *reader) {
+	if ( reader ) {
+		if ( reader->handle ) {
+			switch ( reader->compression ) {
+#ifdef HAVE_ZLIB
+				case COMPRESSION_GZIP:
+					gzclose(reader->handle);
+				break;
+#endif
+#ifdef HAVE_ZSTD
+				case COMPRESSION_ZSTD:
+					ZSTD_freeDCtx(reader->handle);
+				break;
+#endif
+			}
+		}
+		if ( reader->f ) {
+			fclose(reader->f);
+		}
+		free(reader->in);
+		free(reader->buffer);
+		free(reader);
+	}
+}
+
+/*
+	added on October 18, 2026
+
+	returns 1 if reading failed or a compressed file is truncated,
+	so that an end of file can be told apart from a broken file
+*/
+int reader_has_error(const READER *const reader) {
+	assert(reader);
+
+	return reader->error;
+}
+
+/* skip current line up to newline included */
+static int reader_skip_line(READER *const reader) {
+	char *p;
+
+	for ( ; ; ) {
+		if ( (reader->pos == reader->len) && !reader_fill(reader) ) {
+			return 0;
+		}
+		p = memchr(reader->buffer+reader->pos, '\n', reader->len-reader->pos);
+		if ( p ) {
+			reader->pos = (int)(p-reader->buffer)+1;
+			return 1;
+		}
+		reader->pos = reader->len;
+	}
+}
+
+/*
+	move to start of next line, skipping empty ones.
+	as with get_valid_line_from_file a line ends at the first
+	carriage return or newline found.
+	returns 0 on end of file
+*/
+int reader_next_line(READER *const reader) {
+	char c;
+
+	assert(reader);
+
+	if ( reader->in_line ) {
+		reader->in_line = 0;
+		if ( !reader_skip_line(reader) ) {
+			return 0;
+		}
+	}
+
+	for ( ; ; ) {
+		if ( (reader->pos == reader->len) && !reader_fill(reader) ) {
+			return 0;
+		}
+		c = reader->buffer[reader->pos];
+		if ( '\n' == c ) {
+			++reader->pos;
+		} else if ( '\r' == c ) {
+			if ( !reader_skip_line(reader) ) {
+				return 0;
+			}
+		} else {
+			break;
+		}
+	}
+
+	reader->in_line = 1;
+
+	return 1;
+}
+
+/*
+	get next field of current line.
+	if field is NULL value is skipped, otherwise at most size-1 chars are copied.
+	returns field length (that can be greater than size-1) or -1 on end of line
+*/
+int reader_get_field(READER *const reader, char *const field, const int size) {
+	int i;
+	int n;
+	int length;
+	char *p;
+
+	assert(reader && (!field || size > 0));
+
+	if ( field ) {
+		field[0] = '\0';
+	}
+
+	if ( !reader->in_line ) {
+		return -1;
+	}
+
+	/* skip delimiters */
+	for ( ; ; ) {
+		if ( (reader->pos == reader->len) && !reader_fill(reader) ) {
+			reader->in_line = 0;
+			return -1;
+		}
+		i = reader->type[(unsigned char)reader->buffer[reader->pos]];
+		if ( READER_EOL == i ) {
+			return -1;
+		} else if ( READER_CHAR == i ) {
+			break;
+		}
+		++reader->pos;
+	}
+
+	/* scan field */
+	length = 0;
+	for ( ; ; ) {
+		p = reader->buffer + reader->pos;
+		for ( i = 0, n = reader->len - reader->pos; i < n; i++ ) {
+			if ( reader->type[(unsigned char)p[i]] ) {
+				break;
+			}
+		}
+		if ( field && (length < size-1) ) {
+			n = size-1-length;
+			if ( n > i ) {
+				n = i;
+			}
+			memcpy(field+length, p, n);
+			field[length+n] = '\0';
+		}
+		length += i;
+		reader->pos += i;
+		if ( reader->pos < reader->len ) {
+			break;
+		}
+		if ( !reader_fill(reader) ) {
+			break;
+		}
+	}
+
+	return length;
+}
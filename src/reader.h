@@ -0,0 +1,71 @@
+/*
+	reader.h
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef READER_H
+#define READER_H
+
+/* includes */
+#include <stdio.h>
+
+/* constants */
+#define READER_BUFFER_SIZE		(64*1024)
+#define READER_FIELD_SIZE		256
+
+/* compressions */
+enum {
+	COMPRESSION_NONE = 0,
+	COMPRESSION_GZIP,
+	COMPRESSION_ZSTD,
+
+	COMPRESSIONS_COUNT
+};
+
+/* structures */
+typedef struct {
+	int compression;
+	FILE *f;
+	void *handle;
+	void *in;
+	char *buffer;
+	int size;
+	int pos;
+	int len;
+	int in_line;
+	int error;						/* read or decompression failed, input is truncated or corrupted */
+	int frame_open;					/* zstd frame not ended yet */
+	char type[256];
+} READER;
+
+/* prototypes */
+READER *reader_open(const char *const filename, const char *const delimiters);
+READER *reader_open_buffer(char *const buffer, const int size, const char *const delimiters);
+void reader_close(READER *reader);
+int reader_next_line(READER *const reader);
+int reader_get_field(READER *const reader, char *const field, const int size);
+int reader_has_error(const READER *const reader);
+int is_compression_supported(const int compression);
+int get_compression_by_magic(const char *const magic, const int n);
+
+#endif /* READER_H */
@@ -0,0 +1,307 @@
+/*
+	stats.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* includes */
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "stats.h"
+#if defined (_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <time.h>
+#include <sys/resource.h>
+#endif
+
+/* hardware counters are read by phases */
+static int counters_enabled = 0;
+
+/* */
+static const char *const methods[GF_METHODS] = { "all", "driver1", "tofill" };
+
+/* */
+static const char *const stages[GFMDS_STAGES] = {
+	"all 7-14 days",
+	"driver1 7 days",
+	"tofill 0-2 days",
+	"all 21-77 days",
+	"driver1 14-77 days",
+	"tofill 3 days-whole dataset",
+};
+
+/* seconds of a monotonic clock, same of the engine */
+double stats_get_wall_time(void) {
+#if defined (_WIN32)
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart / frequency.QuadPart;
+#else
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+#endif
+}
+
+/* cpu time of calling thread, phases run on a single thread */
+static double get_cpu_time(void) {
+#if defined (_WIN32)
+	FILETIME creation;
+	FILETIME exit;
+	FILETIME kernel;
+	FILETIME user;
+
+	if ( !GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user) ) {
+		return 0;
+	}
+	return (((double)kernel.dwHighDateTime + user.dwHighDateTime) * 4294967296.0 + (double)kernel.dwLowDateTime + user.dwLowDateTime) * 1e-7;
+#else
+	struct timespec t;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+#endif
+}
+
+/*
+	added on October 18, 2026
+	phases started from now on read hardware counters of their thread,
+	returns 0 if no counter is available
+*/
+int stats_enable_counters(void) {
+	PERF perf;
+	double values[PERF_COUNTERS];
+
+	memset(values, 0, sizeof values);
+	if ( perf_start(&perf) ) {
+		counters_enabled = (0 != perf_stop(&perf, values));
+	}
+	return counters_enabled;
+}
+
+/* times are added, so a phase can be started more than once */
+void stats_phase_start(STATS_PHASE *const phase) {
+	assert(phase);
+
+	if ( counters_enabled ) {
+		perf_start(&phase->perf);
+	}
+	phase->start = stats_get_wall_time();
+	phase->wall -= phase->start;
+	phase->cpu -= get_cpu_time();
+}
+
+/* */
+void stats_phase_stop(STATS_PHASE *const phase) {
+	assert(phase);
+
+	phase->end = stats_get_wall_time();
+	phase->wall += phase->end;
+	phase->cpu += get_cpu_time();
+	if ( counters_enabled ) {
+		phase->counters_mask |= perf_stop(&phase->perf, phase->counters);
+	}
+}
+
+/* */
+const char *stats_get_stage_name(const int stage) {
+	assert((stage >= 0) && (stage < GFMDS_STAGES));
+
+	return stages[stage];
+}
+
+/* counts gaps and rows filled by method and time window */
+void stats_count_filled(STATS *const stats, const GF_ROW *const gf_rows, const int rows_count) {
+	int i;
+	int window;
+
+	assert(stats && gf_rows);
+
+	stats->rows_count = rows_count;
+	stats->gaps_count = 0;
+	memset(stats->filled, 0, sizeof stats->filled);
+	for ( i = 0; i < rows_count; i++ ) {
+		if ( !IS_FLAG_SET(gf_rows[i].mask, GF_TOFILL_VALID) ) {
+			++stats->gaps_count;
+		}
+		if ( (gf_rows[i].method > 0) && (gf_rows[i].method <= GF_METHODS) ) {
+			window = gf_rows[i].time_window;
+			if ( window >= STATS_WINDOWS ) {
+				window = STATS_WINDOWS-1;
+			}
+			++stats->filled[gf_rows[i].method-1][window];
+		}
+	}
+}
+
+/* peak resident memory of the process in kB, 0 if not available */
+long stats_get_peak_memory(void) {
+#if defined (_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+
+	if ( !GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof counters) ) {
+		return 0;
+	}
+	return (long)(counters.PeakWorkingSetSize / 1024);
+#else
+	struct rusage usage;
+
+	if ( getrusage(RUSAGE_SELF, &usage) ) {
+		return 0;
+	}
+#if defined (__APPLE__)
+	return usage.ru_maxrss / 1024;
+#else
+	return usage.ru_maxrss;
+#endif
+#endif
+}
+
+/* s as json string */
+void stats_write_string(FILE *const f, const char *s) {
+	fputc('"', f);
+	for ( ; *s; s++ ) {
+		if ( ('"' == *s) || ('\\' == *s) ) {
+			fprintf(f, "\\%c", *s);
+		} else if ( (unsigned char)*s < 0x20 ) {
+			fprintf(f, "\\u%04x", (unsigned char)*s);
+		} else {
+			fputc(*s, f);
+		}
+	}
+	fputc('"', f);
+}
+
+/* rows_scanned, if not 0, gives counters per window row compared by the engine */
+static void write_phase(FILE *const f, const char *const name, const STATS_PHASE *const phase, const double rows_scanned) {
+	int i;
+	int n;
+
+	fprintf(f, "\t\t\t\"%s\": { \"wall\": %.6f, \"cpu\": %.6f", name, phase->wall, phase->cpu);
+	if ( phase->counters_mask ) {
+		fputs(", \"counters\": {", f);
+		n = 0;
+		for ( i = 0; i < PERF_COUNTERS; i++ ) {
+			if ( phase->counters_mask & (1 << i) ) {
+				fprintf(f, "%s \"%s\": %.0f", n++ ? "," : "", perf_get_counter_name(i), phase->counters[i]);
+			}
+		}
+		if ( ((phase->counters_mask & (1 << PERF_CYCLES)) && (phase->counters_mask & (1 << PERF_INSTRUCTIONS))) && phase->counters[PERF_CYCLES] ) {
+			fprintf(f, ", \"ipc\": %.3f", phase->counters[PERF_INSTRUCTIONS] / phase->counters[PERF_CYCLES]);
+		}
+		if ( rows_scanned > 0 ) {
+			fputs(", \"per_scanned_row\": {", f);
+			n = 0;
+			for ( i = 0; i < PERF_COUNTERS; i++ ) {
+				if ( phase->counters_mask & (1 << i) ) {
+					fprintf(f, "%s \"%s\": %.4f", n++ ? "," : "", perf_get_counter_name(i), phase->counters[i] / rows_scanned);
+				}
+			}
+			fputs(" }", f);
+		}
+		fputs(" }", f);
+	}
+	fputs(" },\n", f);
+}
+
+/* returns NULL on error */
+FILE *stats_open(const char *const filename) {
+	FILE *f;
+
+	assert(filename);
+
+	f = fopen(filename, "w");
+	if ( f ) {
+		fputs("{\n\t\"jobs\": [", f);
+	}
+	return f;
+}
+
+/* index is the position of the job in the file, starting from 0 */
+void stats_write_job(FILE *const f, const int index, const char *const name, const int files_count, const STATS *const stats) {
+	int i;
+	int y;
+	int n;
+	double rows_scanned;
+
+	assert(f && name && stats);
+
+	rows_scanned = 0;
+	for ( i = 0; i < GFMDS_STAGES; i++ ) {
+		rows_scanned += stats->engine.rows_scanned[i];
+	}
+
+	fputs(index ? ",\n\t\t{\n" : "\n\t\t{\n", f);
+	fputs("\t\t\t\"name\": ", f);
+	stats_write_string(f, name);
+	fprintf(f, ",\n\t\t\t\"files\": %d,\n", files_count);
+	fprintf(f, "\t\t\t\"rows\": %d,\n", stats->rows_count);
+	fprintf(f, "\t\t\t\"gaps\": %d,\n", stats->gaps_count);
+	fprintf(f, "\t\t\t\"gaps_unfilled\": %d,\n", stats->no_gaps_filled_count);
+	write_phase(f, "import", &stats->import, 0);
+	write_phase(f, "fill", &stats->fill, rows_scanned);
+	write_phase(f, "output", &stats->output, 0);
+	fprintf(f, "\t\t\t\"engine\": {\n\t\t\t\t\"wall\": %.6f,\n\t\t\t\t\"cpu\": %.6f,\n\t\t\t\t\"masks_wall\": %.6f,\n\t\t\t\t\"stages\": [",
+				stats->engine.fill_time, stats->engine.fill_cpu_time, stats->engine.masks_time);
+	for ( i = 0; i < GFMDS_STAGES; i++ ) {
+		fprintf(f, "%s\n\t\t\t\t\t{ \"stage\": \"%s\", \"wall\": %.6f, \"rows_tried\": %d, \"rows_scanned\": %.0f, \"candidates\": %.0f, \"rows_filled\": %d }",
+					i ? "," : "",
+					stages[i],
+					stats->engine.stage_time[i],
+					stats->engine.rows_tried[i],
+					stats->engine.rows_scanned[i],
+					stats->engine.candidates[i],
+					stats->engine.rows_filled[i]
+		);
+	}
+	fputs("\n\t\t\t\t]\n\t\t\t},\n\t\t\t\"filled\": {", f);
+	for ( i = 0; i < GF_METHODS; i++ ) {
+		fprintf(f, "%s\n\t\t\t\t\"%s\": {", i ? "," : "", methods[i]);
+		n = 0;
+		for ( y = 0; y < STATS_WINDOWS; y++ ) {
+			if ( stats->filled[i][y] ) {
+				fprintf(f, "%s \"%d%s\": %d", n++ ? "," : "", y, (STATS_WINDOWS-1 == y) ? "+" : "", stats->filled[i][y]);
+			}
+		}
+		fputs(n ? " }" : "}", f);
+	}
+	fprintf(f, "\n\t\t\t},\n\t\t\t\"peak_memory_kb\": %ld\n\t\t}", stats->peak_memory);
+}
+
+/* returns 0 on error */
+int stats_close(FILE *const f) {
+	int error;
+
+	assert(f);
+
+	fputs("\n\t]\n}\n", f);
+	error = ferror(f);
+	return !fclose(f) && !error;
+}
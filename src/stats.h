@@ -0,0 +1,84 @@
+/*
+	stats.h
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	phase timers and counters of a job, added on October 18, 2026
+
+	they are collected only if gf_mds is built with GF_STATS (make STATS=1)
+	and written as json by -stats
+*/
+
+#ifndef STATS_H
+#define STATS_H
+
+/* includes */
+#include <stdio.h>
+#include "common.h"
+#include "perf.h"
+
+/* constants */
+#define STATS_WINDOWS			160		/* time windows counted one by one, bigger ones go in the last */
+
+/* structures */
+/*
+	wall, cpu and counters add up every run of the phase, start and end
+	are of last run. counters_mask has a bit for each counter read
+*/
+typedef struct {
+	double wall;
+	double cpu;
+	double start;
+	double end;
+	double counters[PERF_COUNTERS];
+	int counters_mask;
+	PERF perf;
+} STATS_PHASE;
+
+typedef struct {
+	int rows_count;
+	int gaps_count;
+	int no_gaps_filled_count;
+	STATS_PHASE import;
+	STATS_PHASE fill;
+	STATS_PHASE output;
+	GFMDS_STATS engine;
+	int filled[GF_METHODS][STATS_WINDOWS];		/* rows filled by method and time window */
+	long peak_memory;							/* kB, of the whole process */
+} STATS;
+
+/* prototypes */
+double stats_get_wall_time(void);
+int stats_enable_counters(void);
+void stats_phase_start(STATS_PHASE *const phase);
+void stats_phase_stop(STATS_PHASE *const phase);
+const char *stats_get_stage_name(const int stage);
+void stats_count_filled(STATS *const stats, const GF_ROW *const gf_rows, const int rows_count);
+long stats_get_peak_memory(void);
+void stats_write_string(FILE *const f, const char *s);
+FILE *stats_open(const char *const filename);
+void stats_write_job(FILE *const f, const int index, const char *const name, const int files_count, const STATS *const stats);
+int stats_close(FILE *const f);
+
+#endif /* STATS_H */
@@ -0,0 +1,286 @@
+/*
+	thread.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	thin wrapper over win32 and posix threads, added on October 18, 2026
+*/
+
+/* includes */
+#include <stdlib.h>
+#include <assert.h>
+#include "thread.h"
+#if !defined (_WIN32)
+#include <unistd.h>
+#endif
+
+/* structures */
+typedef struct {
+	void (*f)(void *);
+	void *p;
+} THREAD_START;
+
+/* */
+#if defined (_WIN32)
+static DWORD WINAPI thread_start(LPVOID p) {
+#else
+static void *thread_start(void *p) {
+#endif
+	THREAD_START s;
+
+	s = *(THREAD_START *)p;
+	free(p);
+	s.f(s.p);
+
+	return 0;
+}
+
+/* */
+int thread_create(THREAD *const thread, void (*f)(void *), void *const p) {
+	THREAD_START *s;
+
+	assert(thread && f);
+
+	s = malloc(sizeof*s);
+	if ( !s ) {
+		return 0;
+	}
+	s->f = f;
+	s->p = p;
+
+#if defined (_WIN32)
+	*thread = CreateThread(NULL, 0, thread_start, s, 0, NULL);
+	if ( !*thread ) {
+		free(s);
+		return 0;
+	}
+#else
+	if ( pthread_create(thread, NULL, thread_start, s) ) {
+		free(s);
+		return 0;
+	}
+#endif
+
+	return 1;
+}
+
+/* */
+void thread_join(THREAD *const thread) {
+	assert(thread);
+#if defined (_WIN32)
+	WaitForSingleObject(*thread, INFINITE);
+	CloseHandle(*thread);
+#else
+	pthread_join(*thread, NULL);
+#endif
+}
+
+/* */
+int mutex_init(MUTEX *const mutex) {
+	assert(mutex);
+#if defined (_WIN32)
+	InitializeCriticalSection(mutex);
+	return 1;
+#else
+	return !pthread_mutex_init(mutex, NULL);
+#endif
+}
+
+/* */
+void mutex_destroy(MUTEX *const mutex) {
+	assert(mutex);
+#if defined (_WIN32)
+	DeleteCriticalSection(mutex);
+#else
+	pthread_mutex_destroy(mutex);
+#endif
+}
+
+/* */
+void mutex_lock(MUTEX *const mutex) {
+	assert(mutex);
+#if defined (_WIN32)
+	EnterCriticalSection(mutex);
+#else
+	pthread_mutex_lock(mutex);
+#endif
+}
+
+/* */
+void mutex_unlock(MUTEX *const mutex) {
+	assert(mutex);
+#if defined (_WIN32)
+	LeaveCriticalSection(mutex);
+#else
+	pthread_mutex_unlock(mutex);
+#endif
+}
+
+/* */
+int condition_init(CONDITION *const condition) {
+	assert(condition);
+#if defined (_WIN32)
+	InitializeConditionVariable(condition);
+	return 1;
+#else
+	return !pthread_cond_init(condition, NULL);
+#endif
+}
+
+/* */
+void condition_destroy(CONDITION *const condition) {
+	assert(condition);
+#if !defined (_WIN32)
+	pthread_cond_destroy(condition);
+#endif
+}
+
+/* */
+void condition_wait(CONDITION *const condition, MUTEX *const mutex) {
+	assert(condition && mutex);
+#if defined (_WIN32)
+	SleepConditionVariableCS(condition, mutex, INFINITE);
+#else
+	pthread_cond_wait(condition, mutex);
+#endif
+}
+
+/* */
+void condition_signal(CONDITION *const condition) {
+	assert(condition);
+#if defined (_WIN32)
+	WakeConditionVariable(condition);
+#else
+	pthread_cond_signal(condition);
+#endif
+}
+
+/* */
+void condition_broadcast(CONDITION *const condition) {
+	assert(condition);
+#if defined (_WIN32)
+	WakeAllConditionVariable(condition);
+#else
+	pthread_cond_broadcast(condition);
+#endif
+}
+
+/* */
+int get_cpus_count(void) {
+	int count;
+#if defined (_WIN32)
+	SYSTEM_INFO si;
+
+	GetSystemInfo(&si);
+	count = (int)si.dwNumberOfProcessors;
+#elif defined (_SC_NPROCESSORS_ONLN)
+	count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#else
+	count = 1;
+#endif
+	return (count < 1) ? 1 : count;
+}
+
+/* added on October 18, 2026: id of calling thread, used only to tell threads apart */
+unsigned long thread_get_id(void) {
+#if defined (_WIN32)
+	return (unsigned long)GetCurrentThreadId();
+#else
+	return (unsigned long)pthread_self();
+#endif
+}
+
+/* added on October 18, 2026 */
+int queue_init(QUEUE *const queue, const int size) {
+	assert(queue && (size > 0));
+
+	queue->items = malloc(size*sizeof*queue->items);
+	if ( !queue->items ) {
+		return 0;
+	}
+	if ( !mutex_init(&queue->mutex) ) {
+		free(queue->items);
+		return 0;
+	}
+	if ( !condition_init(&queue->not_empty) ) {
+		mutex_destroy(&queue->mutex);
+		free(queue->items);
+		return 0;
+	}
+	if ( !condition_init(&queue->not_full) ) {
+		condition_destroy(&queue->not_empty);
+		mutex_destroy(&queue->mutex);
+		free(queue->items);
+		return 0;
+	}
+	queue->size = size;
+	queue->count = 0;
+	queue->head = 0;
+
+	return 1;
+}
+
+/* added on October 18, 2026 */
+void queue_destroy(QUEUE *const queue) {
+	assert(queue);
+
+	condition_destroy(&queue->not_full);
+	condition_destroy(&queue->not_empty);
+	mutex_destroy(&queue->mutex);
+	free(queue->items);
+	queue->items = NULL;
+}
+
+/* added on October 18, 2026 */
+void queue_push(QUEUE *const queue, void *const item) {
+	assert(queue);
+
+	mutex_lock(&queue->mutex);
+	while ( queue->count == queue->size ) {
+		condition_wait(&queue->not_full, &queue->mutex);
+	}
+	queue->items[(queue->head + queue->count) % queue->size] = item;
+	++queue->count;
+	condition_signal(&queue->not_empty);
+	mutex_unlock(&queue->mutex);
+}
+
+/* added on October 18, 2026 */
+void *queue_pop(QUEUE *const queue) {
+	void *item;
+
+	assert(queue);
+
+	mutex_lock(&queue->mutex);
+	while ( !queue->count ) {
+		condition_wait(&queue->not_empty, &queue->mutex);
+	}
+	item = queue->items[queue->head];
+	queue->head = (queue->head + 1) % queue->size;
+	--queue->count;
+	condition_signal(&queue->not_full);
+	mutex_unlock(&queue->mutex);
+
+	return item;
+}
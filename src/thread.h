@@ -0,0 +1,82 @@
+/*
+	thread.h
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef THREAD_H
+#define THREAD_H
+
+/* os dependant */
+#if defined (_WIN32)
+#ifndef STRICT
+#define STRICT
+#endif /* STRICT */
+#ifndef WIN32_MEAN_AND_LEAN
+#define WIN32_MEAN_AND_LEAN
+#endif /* WIN32_MEAN_AND_LEAN */
+#include <windows.h>
+typedef HANDLE THREAD;
+typedef CRITICAL_SECTION MUTEX;
+typedef CONDITION_VARIABLE CONDITION;
+#else
+#include <pthread.h>
+typedef pthread_t THREAD;
+typedef pthread_mutex_t MUTEX;
+typedef pthread_cond_t CONDITION;
+#endif
+
+/*
+	bounded queue of pointers, added on October 18, 2026
+
+	queue_push blocks while the queue is full, queue_pop while it is empty
+*/
+typedef struct {
+	void **items;
+	int size;
+	int count;
+	int head;
+	MUTEX mutex;
+	CONDITION not_empty;
+	CONDITION not_full;
+} QUEUE;
+
+/* prototypes */
+int thread_create(THREAD *const thread, void (*f)(void *), void *const p);
+void thread_join(THREAD *const thread);
+int mutex_init(MUTEX *const mutex);
+void mutex_destroy(MUTEX *const mutex);
+void mutex_lock(MUTEX *const mutex);
+void mutex_unlock(MUTEX *const mutex);
+int condition_init(CONDITION *const condition);
+void condition_destroy(CONDITION *const condition);
+void condition_wait(CONDITION *const condition, MUTEX *const mutex);
+void condition_signal(CONDITION *const condition);
+void condition_broadcast(CONDITION *const condition);
+int get_cpus_count(void);
+unsigned long thread_get_id(void);
+int queue_init(QUEUE *const queue, const int size);
+void queue_destroy(QUEUE *const queue);
+void queue_push(QUEUE *const queue, void *const item);
+void *queue_pop(QUEUE *const queue);
+
+#endif /* THREAD_H */
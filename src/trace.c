@@ -0,0 +1,167 @@
+/*
+	trace.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "trace.h"
+#include "stats.h"
+
+/* starts an event, must be called with mutex locked */
+static void begin_event(TRACE *const trace) {
+	fputs(trace->events_count++ ? ",\n" : "\n", trace->f);
+}
+
+/*
+	index of calling thread, must be called with mutex locked.
+	threads are named in order of first event
+*/
+static int get_thread(TRACE *const trace) {
+	int i;
+	unsigned long id;
+
+	id = thread_get_id();
+	for ( i = 0; i < trace->threads_count; i++ ) {
+		if ( trace->threads[i] == id ) {
+			return i+1;
+		}
+	}
+	if ( trace->threads_count < TRACE_THREADS_MAX ) {
+		trace->threads[trace->threads_count++] = id;
+	}
+	begin_event(trace);
+	fprintf(trace->f, "{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": { \"name\": \"thread %d\" } }", i+1, i+1);
+	return i+1;
+}
+
+/* span on thread, times are seconds of stats_get_wall_time */
+static void write_span(TRACE *const trace, const int thread, const char *const name, const char *const category, const double start, const double end) {
+	begin_event(trace);
+	fputs("{ \"name\": ", trace->f);
+	stats_write_string(trace->f, name);
+	fprintf(trace->f, ", \"cat\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f",
+					category, thread, (start - trace->origin) * 1e6, (end - start) * 1e6);
+}
+
+/* returns NULL on error */
+TRACE *trace_open(const char *const filename) {
+	TRACE *trace;
+
+	assert(filename);
+
+	trace = malloc(sizeof*trace);
+	if ( !trace ) {
+		return NULL;
+	}
+	if ( !mutex_init(&trace->mutex) ) {
+		free(trace);
+		return NULL;
+	}
+	trace->f = fopen(filename, "w");
+	if ( !trace->f ) {
+		mutex_destroy(&trace->mutex);
+		free(trace);
+		return NULL;
+	}
+	trace->origin = stats_get_wall_time();
+	trace->events_count = 0;
+	trace->threads_count = 0;
+	fputs("{ \"displayTimeUnit\": \"ms\", \"traceEvents\": [", trace->f);
+
+	return trace;
+}
+
+/* span of a phase on calling thread */
+void trace_span(TRACE *const trace, const char *const name, const char *const group, const double start, const double end) {
+	assert(trace && name && group);
+
+	mutex_lock(&trace->mutex);
+	write_span(trace, get_thread(trace), name, "phase", start, end);
+	fputs(", \"args\": { \"group\": ", trace->f);
+	stats_write_string(trace->f, group);
+	fputs(" } }", trace->f);
+	mutex_unlock(&trace->mutex);
+}
+
+/* file group from its first to its last phase, phases can be on different threads */
+void trace_group(TRACE *const trace, const int id, const char *const group, const double start, const double end) {
+	assert(trace && group);
+
+	mutex_lock(&trace->mutex);
+	begin_event(trace);
+	fputs("{ \"name\": ", trace->f);
+	stats_write_string(trace->f, group);
+	fprintf(trace->f, ", \"cat\": \"group\", \"ph\": \"b\", \"id\": %d, \"pid\": 1, \"ts\": %.3f }", id, (start - trace->origin) * 1e6);
+	begin_event(trace);
+	fputs("{ \"name\": ", trace->f);
+	stats_write_string(trace->f, group);
+	fprintf(trace->f, ", \"cat\": \"group\", \"ph\": \"e\", \"id\": %d, \"pid\": 1, \"ts\": %.3f }", id, (end - trace->origin) * 1e6);
+	mutex_unlock(&trace->mutex);
+}
+
+/*
+	run of rows from the engine on calling thread. stages of different
+	rows interleave, so each stage is drawn as one child span long as the
+	time spent in it and children are placed one after the other
+*/
+void trace_run(TRACE *const trace, const char *const group, const GFMDS_TRACE_RUN *const run) {
+	int i;
+	int thread;
+	double start;
+
+	assert(trace && group && run);
+
+	mutex_lock(&trace->mutex);
+	thread = get_thread(trace);
+	write_span(trace, thread, run->gaps ? "gaps" : "values", "engine", run->start, run->end);
+	fputs(", \"args\": { \"group\": ", trace->f);
+	stats_write_string(trace->f, group);
+	fprintf(trace->f, ", \"first_row\": %d, \"rows\": %d } }", run->first_row, run->rows_count);
+	start = run->start;
+	for ( i = 0; i < GFMDS_STAGES; i++ ) {
+		if ( run->stage_rows[i] ) {
+			write_span(trace, thread, stats_get_stage_name(i), "stage", start, start + run->stage_time[i]);
+			fprintf(trace->f, ", \"args\": { \"rows\": %d } }", run->stage_rows[i]);
+			start += run->stage_time[i];
+		}
+	}
+	mutex_unlock(&trace->mutex);
+}
+
+/* returns 0 on error */
+int trace_close(TRACE *const trace) {
+	int error;
+
+	assert(trace);
+
+	fputs("\n] }\n", trace->f);
+	error = ferror(trace->f);
+	error |= fclose(trace->f);
+	mutex_destroy(&trace->mutex);
+	free(trace);
+
+	return !error;
+}
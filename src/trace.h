@@ -0,0 +1,64 @@
+/*
+	trace.h
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	timeline of a run as chrome trace events, added on October 18, 2026
+
+	written by -trace when gf_mds is built with GF_STATS (make STATS=1),
+	open it with chrome://tracing or ui.perfetto.dev.
+	file groups are async spans, phases are spans on the thread that ran
+	them and the engine adds a span for each run of consecutive gaps (or
+	valid values) with the time of each cascade stage as children
+*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+/* includes */
+#include <stdio.h>
+#include "thread.h"
+#include "gfmds.h"
+
+/* constants */
+#define TRACE_THREADS_MAX		(256+2)		/* see THREADS_MAX in main.c */
+
+/* structures */
+typedef struct {
+	FILE *f;
+	double origin;
+	int events_count;
+	unsigned long threads[TRACE_THREADS_MAX];
+	int threads_count;
+	MUTEX mutex;
+} TRACE;
+
+/* prototypes */
+TRACE *trace_open(const char *const filename);
+void trace_span(TRACE *const trace, const char *const name, const char *const group, const double start, const double end);
+void trace_group(TRACE *const trace, const int id, const char *const group, const double start, const double end);
+void trace_run(TRACE *const trace, const char *const group, const GFMDS_TRACE_RUN *const run);
+int trace_close(TRACE *const trace);
+
+#endif /* TRACE_H */
@@ -0,0 +1,317 @@
+/*
+	writer.c
+
+	this file is part of gf_mds
+
+	author: Alessio Ribeca <a.ribeca@unitus.it>
+	owner: DIBAF - University of Tuscia, Viterbo, Italy
+
+	scientific contact: Dario Papale <darpap@unitus.it>
+*/
+
+/*
+Copyright 2014-2019 DIBAF - University of Tuscia, Viterbo, Italy
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+	buffered output writer, added on October 18, 2026
+
+	data is collected in big blocks. compressed files (gzip with
+	HAVE_ZLIB, zstd with HAVE_ZSTD) are compressed by a dedicated thread
+	while next block is filled, so formatting and compression overlap.
+*/
+
+/* includes */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "writer.h"
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+/* constants */
+#define ZSTD_LEVEL		3
+
+/* strings */
+static const char *compression_extensions[COMPRESSIONS_COUNT] = { "", ".gz", ".zst" };
+
+/* */
+const char *get_compression_extension(const int compression) {
+	assert((compression >= 0) && (compression < COMPRESSIONS_COUNT));
+
+	return compression_extensions[compression];
+}
+
+/* */
+static int writer_compress(WRITER *const writer, const char *const data, const int size, const int end) {
+#ifdef HAVE_ZSTD
+	size_t ret;
+	ZSTD_inBuffer in;
+	ZSTD_outBuffer out;
+#else
+	(void)end;
+#endif
+
+	switch ( writer->compression ) {
+#ifdef HAVE_ZLIB
+		case COMPRESSION_GZIP:
+			return !size || (gzwrite(writer->handle, data, size) == size);
+#endif
+
+#ifdef HAVE_ZSTD
+		case COMPRESSION_ZSTD:
+			in.src = data;
+			in.size = size;
+			in.pos = 0;
+			do {
+				out.dst = writer->out;
+				out.size = ZSTD_CStreamOutSize();
+				out.pos = 0;
+				ret = ZSTD_compressStream2(writer->handle, &out, &in, end ? ZSTD_e_end : ZSTD_e_continue);
+				if ( ZSTD_isError(ret) ) {
+					return 0;
+				}
+				if ( out.pos && (1 != fwrite(out.dst, out.pos, 1, writer->f)) ) {
+					return 0;
+				}
+			} while ( end ? (ret != 0) : (in.pos < in.size) );
+			return 1;
+#endif
+
+		default:
+			return !size || (1 == fwrite(data, size, 1, writer->f));
+	}
+}
+
+/* compression thread */
+static void writer_thread(void *p) {
+	int i;
+	WRITER *writer;
+
+	writer = p;
+	mutex_lock(&writer->mutex);
+	for ( ; ; ) {
+		while ( (-1 == writer->pending) && !writer->quit ) {
+			condition_wait(&writer->condition, &writer->mutex);
+		}
+		if ( -1 == writer->pending ) {
+			break;
+		}
+		i = writer->pending;
+		mutex_unlock(&writer->mutex);
+
+		i = writer_compress(writer, writer->buffers[i], writer->sizes[i], 0);
+
+		mutex_lock(&writer->mutex);
+		if ( !i ) {
+			writer->error = 1;
+		}
+		writer->pending = -1;
+		condition_broadcast(&writer->condition);
+	}
+	mutex_unlock(&writer->mutex);
+}
+
+/* */
+static int writer_flush(WRITER *const writer) {
+	if ( !writer->sizes[writer->current] ) {
+		return !writer->error;
+	}
+
+	if ( !writer->threaded ) {
+		if ( !writer_compress(writer, writer->buffers[writer->current], writer->sizes[writer->current], 0) ) {
+			writer->error = 1;
+		}
+		writer->sizes[writer->current] = 0;
+		return !writer->error;
+	}
+
+	/* hand current buffer to compression thread and switch to the other one */
+	mutex_lock(&writer->mutex);
+	while ( -1 != writer->pending ) {
+		condition_wait(&writer->condition, &writer->mutex);
+	}
+	writer->pending = writer->current;
+	condition_broadcast(&writer->condition);
+	mutex_unlock(&writer->mutex);
+
+	writer->current ^= 1;
+	writer->sizes[writer->current] = 0;
+
+	return !writer->error;
+}
+
+/*
+	updated on October 18, 2026: binary files, as bin output, are not
+	opened in text mode that would change their newline bytes on windows
+*/
+WRITER *writer_open(const char *const filename, const int compression, const int binary) {
+	WRITER *writer;
+
+	assert(filename && is_compression_supported(compression));
+
+	writer = malloc(sizeof*writer);
+	if ( !writer ) {
+		return NULL;
+	}
+	memset(writer, 0, sizeof*writer);
+	writer->compression = compression;
+	writer->pending = -1;
+
+	writer->buffers[0] = malloc(WRITER_BUFFER_SIZE);
+	if ( !writer->buffers[0] ) {
+		free(writer);
+		return NULL;
+	}
+
+	switch ( compression ) {
+#ifdef HAVE_ZLIB
+		case COMPRESSION_GZIP:
+			writer->handle = gzopen(filename, "wb");
+			if ( !writer->handle ) {
+				free(writer->buffers[0]);
+				free(writer);
+				return NULL;
+			}
+		break;
+#endif
+
+#ifdef HAVE_ZSTD
+		case COMPRESSION_ZSTD:
+			writer->handle = ZSTD_createCCtx();
+			writer->out = malloc(ZSTD_CStreamOutSize());
+			writer->f = fopen(filename, "wb");
+			if ( !writer->handle || !writer->out || !writer->f ) {
+				if ( writer->f ) {
+					fclose(writer->f);
+				}
+				free(writer->out);
+				ZSTD_freeCCtx(writer->handle);
+				free(writer->buffers[0]);
+				free(writer);
+				return NULL;
+			}
+			ZSTD_CCtx_setParameter(writer->handle, ZSTD_c_compressionLevel, ZSTD_LEVEL);
+		break;
+#endif
+
+		default:
+			/* text mode as csv output has always been written */
+			writer->f = fopen(filename, binary ? "wb" : "w");
+			if ( !writer->f ) {
+				free(writer->buffers[0]);
+				free(writer);
+				return NULL;
+			}
+	}
+
+	/* compression runs on its own thread, if we can't create it we compress inline */
+	if ( COMPRESSION_NONE != compression ) {
+		writer->buffers[1] = malloc(WRITER_BUFFER_SIZE);
+		if ( writer->buffers[1] ) {
+			if ( mutex_init(&writer->mutex) ) {
+				if ( condition_init(&writer->condition) ) {
+					writer->threaded = thread_create(&writer->thread, writer_thread, writer);
+					if ( !writer->threaded ) {
+						condition_destroy(&writer->condition);
+					}
+				}
+				if ( !writer->threaded ) {
+					mutex_destroy(&writer->mutex);
+				}
+			}
+		}
+	}
+
+	return writer;
+}
+
+/* */
+int writer_write(WRITER *const writer, const char *const data, const int size) {
+	int i;
+	int n;
+
+	assert(writer && data);
+
+	for ( i = 0; i < size; i += n ) {
+		n = WRITER_BUFFER_SIZE - writer->sizes[writer->current];
+		if ( !n ) {
+			if ( !writer_flush(writer) ) {
+				return 0;
+			}
+			n = WRITER_BUFFER_SIZE;
+		}
+		if ( n > size - i ) {
+			n = size - i;
+		}
+		memcpy(writer->buffers[writer->current]+writer->sizes[writer->current], data+i, n);
+		writer->sizes[writer->current] += n;
+	}
+
+	return !writer->error;
+}
+
+/* returns 0 if any error occurred */
+int writer_close(WRITER *writer) {
+	int error;
+
+	if ( !writer ) {
+		return 0;
+	}
+
+	writer_flush(writer);
+
+	if ( writer->threaded ) {
+		mutex_lock(&writer->mutex);
+		writer->quit = 1;
+		condition_broadcast(&writer->condition);
+		mutex_unlock(&writer->mutex);
+		thread_join(&writer->thread);
+		condition_destroy(&writer->condition);
+		mutex_destroy(&writer->mutex);
+	}
+
+	error = writer->error;
+	switch ( writer->compression ) {
+#ifdef HAVE_ZLIB
+		case COMPRESSION_GZIP:
+			if ( Z_OK != gzclose(writer->handle) ) {
+				error = 1;
+			}
+		break;
+#endif
+
+#ifdef HAVE_ZSTD
+		case COMPRESSION_ZSTD:
+			if ( !writer_compress(writer, NULL, 0, 1) ) {
+				error = 1;
+			}
+			ZSTD_freeCCtx(writer->handle);
+			free(writer->out);
+		break;
+#endif
+	}
+	if ( writer->f && fclose(writer->f) ) {
+		error = 1;
+	}
+
+	free(writer->buffers[1]);
+	free(writer->buffers[0]);
+	free(writer);
+
+	return !error;
+}